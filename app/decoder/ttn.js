@@ -4,9 +4,212 @@ function decodeUplink(input) {
     return value > 0x7fff ? value - 0x10000 : value;
   }
 
+  function readUnsigned(size) {
+    var value = 0;
+    for (var i = 0; i < size; i++) {
+      value = value * 256 + bytes[index++];
+    }
+    return value;
+  }
+
+  // Channels of extension records (bit position in channel mask = array index)
+  var channels = [
+    { name: 'voltage', size: 1, decode: function (v) { return v === 0xff ? null : v / 50; } },
+    { name: 'temperature', size: 2, signed: true, decode: function (v) { return v === 0x7fff ? null : toSignedInt16(v) / 100; } },
+    { name: 'humidity', size: 1, decode: function (v) { return v === 0xff ? null : v / 2; } },
+    { name: 'illuminance', size: 2, decode: function (v) { return v === 0xffff ? null : v * 2; } },
+    { name: 'ext_temperature_1', size: 2, signed: true, decode: function (v) { return v === 0x7fff ? null : toSignedInt16(v) / 100; } },
+    { name: 'ext_temperature_2', size: 2, signed: true, decode: function (v) { return v === 0x7fff ? null : toSignedInt16(v) / 100; } },
+    { name: 'altitude', size: 2, signed: true, decode: function (v) { return v === 0x7fff ? null : toSignedInt16(v) / 10; } },
+    { name: 'pressure', size: 4, decode: function (v) { return v === 0xffffffff ? null : v; } },
+    { name: 'machine_probe_temperature_1', size: 2, signed: true, decode: function (v) { return v === 0x7fff ? null : toSignedInt16(v) / 100; } },
+    { name: 'machine_probe_temperature_2', size: 2, signed: true, decode: function (v) { return v === 0x7fff ? null : toSignedInt16(v) / 100; } },
+    { name: 'machine_probe_humidity_1', size: 1, decode: function (v) { return v === 0xff ? null : v / 2; } },
+    { name: 'machine_probe_humidity_2', size: 1, decode: function (v) { return v === 0xff ? null : v / 2; } }
+  ];
+
+  function readChannel(channel) {
+    return channel.decode(readUnsigned(channel.size));
+  }
+
+  function readVarint() {
+    var value = 0;
+    var scale = 1;
+    var b;
+    do {
+      b = bytes[index++];
+      value += (b & 0x7f) * scale;
+      scale *= 128;
+    } while (b & 0x80);
+    return value;
+  }
+
+  function readZigZag() {
+    var value = readVarint();
+    return value % 2 ? -(value + 1) / 2 : value / 2;
+  }
+
+  // Raw channel value as signed integer (deltas are computed on these)
+  function toCode(channel, raw) {
+    return channel.signed ? toSignedInt16(raw) : raw;
+  }
+
+  function fromCode(channel, code) {
+    return channel.signed ? (code + 0x10000) % 0x10000 : code;
+  }
+
+  function decodeAggregation(end) {
+    var aggregation = { interval: readUnsigned(4), windows: [] };
+    var count = bytes[index++];
+    var mask = readUnsigned(2);
+
+    for (var w = 0; w < count && index < end; w++) {
+      var stats = {};
+      for (var i = 0; i < channels.length; i++) {
+        if (mask & (1 << i)) {
+          stats[channels[i].name] = {
+            min: readChannel(channels[i]),
+            max: readChannel(channels[i]),
+            mean: readChannel(channels[i]),
+            last: readChannel(channels[i])
+          };
+        }
+      }
+      aggregation.windows.push(stats);
+    }
+
+    return aggregation;
+  }
+
+  function decodeBatch(end, compressed) {
+    var age = readUnsigned(4);
+    var count = bytes[index++];
+    var mask = readUnsigned(2);
+    var samples = [];
+    var codes = [];
+
+    for (var s = 0; s < count && index < end; s++) {
+      // Compressed samples after the first one are zig-zag varint deltas
+      var delta = compressed && s > 0;
+      if (s > 0 || !compressed) {
+        age -= compressed ? readVarint() : readUnsigned(2);
+      }
+      var sample = { age: age };
+      for (var i = 0; i < channels.length; i++) {
+        if (mask & (1 << i)) {
+          if (delta) {
+            codes[i] += readZigZag();
+          } else {
+            codes[i] = toCode(channels[i], readUnsigned(channels[i].size));
+          }
+          sample[channels[i].name] = channels[i].decode(fromCode(channels[i], codes[i]));
+        }
+      }
+      samples.push(sample);
+    }
+
+    return { samples: samples };
+  }
+
+  // Alarms (bit position in alarm state = array index)
+  var alarms = [
+    'temperature', 'humidity', 'pressure', 'ext_temperature_1', 'ext_temperature_2', 'illuminance',
+    'machine_probe_temperature_1', 'machine_probe_temperature_2',
+    'machine_probe_humidity_1', 'machine_probe_humidity_2', 'rate_of_change', 'stuck_sensor'
+  ];
+
+  function decodeAlarm() {
+    var state = readUnsigned(2);
+    var active = [];
+    for (var i = 0; i < alarms.length; i++) {
+      if (state & (1 << i)) {
+        active.push(alarms[i]);
+      }
+    }
+    return active;
+  }
+
+  function decodePulse() {
+    var mask = bytes[index++];
+    var pulse = { interval: readUnsigned(4) };
+    var names = ['input_a', 'input_b'];
+
+    for (var i = 0; i < names.length; i++) {
+      if (mask & (1 << i)) {
+        var pulses = readUnsigned(4);
+        var min = readUnsigned(4);
+        var max = readUnsigned(4);
+        pulse[names[i]] = {
+          pulses: pulses,
+          rate_per_hour: pulse.interval ? pulses * 3600 / pulse.interval : null,
+          period_min: min === 0xffffffff ? null : min,
+          period_max: max === 0xffffffff ? null : max
+        };
+      }
+    }
+
+    return pulse;
+  }
+
+  // Thermometers beyond the fixed two, numbered by their slot
+  function decodeThermometers() {
+    var mask = bytes[index++];
+
+    for (var i = 0; i < 8; i++) {
+      if (mask & (1 << i)) {
+        data['ext_temperature_' + (i + 1)] = toSignedInt16(readUnsigned(2)) / 100;
+      }
+    }
+  }
+
+  // Machine probes beyond the fixed two, numbered by their slot
+  function decodeMachineProbes() {
+    var mask = bytes[index++];
+    var tilt_mask = bytes[index++];
+
+    for (var i = 0; i < 8; i++) {
+      if (mask & (1 << i)) {
+        var temperature = readUnsigned(2);
+        var humidity = bytes[index++];
+        data['machine_probe_temperature_' + (i + 1)] = toSignedInt16(temperature) / 100;
+        data['machine_probe_humidity_' + (i + 1)] = humidity === 0xff ? null : humidity / 2;
+      }
+      if (i >= 2) {
+        data['machine_probe_tilt_alert_' + (i + 1)] = (tilt_mask & (1 << i)) ? true : false;
+      }
+    }
+  }
+
+  // Counters of compressed reports as deltas to the previous report (bit position in counter
+  // mask = array index, modulo 2^32), omitted counters did not change
+  function decodeCounters() {
+    var mask = bytes[index++];
+    var names = ['motion_count', 'hall_left_count', 'hall_right_count', 'input_a_count', 'input_b_count'];
+
+    for (var i = 0; i < names.length; i++) {
+      data[names[i] + '_delta'] = (mask & (1 << i)) ? readZigZag() : 0;
+      if (i >= 3 && (mask & (1 << i))) {
+        var input = i === 3 ? 'input_a' : 'input_b';
+        var status = bytes[index++];
+        data[input + '_notify_act'] = (status & (1 << 3)) ? true : false;
+        data[input + '_notify_deact'] = (status & (1 << 2)) ? true : false;
+        data[input + '_is_active'] = (status & (1 << 0)) ? true : false;
+      }
+    }
+  }
+
   var data = {};
   var bytes = input.bytes;
   var index = 0;
+
+  // Reports stored while the link was down (port 2) are prefixed by their age in seconds
+  if (input.fPort === 2 && bytes.length >= 4) {
+    var age = readUnsigned(4);
+    data.queued = true;
+    data.age = age === 0xffffffff ? null : age;
+    bytes = bytes.slice(4);
+    index = 0;
+  }
   var isExtendedPacket = false;
   var header = 0;
 
@@ -195,6 +398,36 @@ function decodeUplink(input) {
       data.input_b_notify_deact = false;
       data.input_b_is_active = false;
     }
+
+    // Extension records: tag, length, data
+    while (index + 2 <= bytes.length) {
+      var tag = bytes[index++];
+      var length = bytes[index++];
+      var end = index + length;
+
+      if (tag === 0x01) {
+        data.aggregation = decodeAggregation(end);
+      } else if (tag === 0x02) {
+        data.batch = decodeBatch(end, false);
+      } else if (tag === 0x03) {
+        data.batch = decodeBatch(end, true);
+      } else if (tag === 0x04) {
+        data.pulse = decodePulse();
+      } else if (tag === 0x05) {
+        data.alarms = decodeAlarm();
+      } else if (tag === 0x06) {
+        data.w1_topology_changed = true;
+        data.w1_devices = bytes[index];
+      } else if (tag === 0x07) {
+        decodeThermometers();
+      } else if (tag === 0x08) {
+        decodeMachineProbes();
+      } else if (tag === 0x09) {
+        decodeCounters();
+      }
+
+      index = end;
+    }
   }
 
   return {
@@ -6,176 +6,329 @@
 
 #include "app_alarm.h"
 #include "app_config.h"
-#include "app_sensor.h"
+#include "app_history.h"
+#include "app_lrw.h"
+#include "app_main.h"
 
 /* Zephyr includes */
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
 
 /* Standard includes */
-#include <errno.h>
 #include <math.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 LOG_MODULE_REGISTER(app_alarm, LOG_LEVEL_DBG);
 
-bool app_alarm_is_active(void)
+/* Token bucket of the uplinks on alarm transitions */
+#define NOTIFY_BURST          3  /* Uplinks allowed back to back */
+#define NOTIFY_REFILL_MIN_SEC 60 /* Minimum time to regain one uplink */
+
+/* Additional checks of the channel */
+#define CHECK_ROC   BIT(0) /* Rate of change (temperatures) */
+#define CHECK_STUCK BIT(1) /* Reading not changing */
+
+struct alarm {
+	const char *name;
+	enum app_history_channel channel;
+	/* Multiplier converting the sample value to the threshold unit */
+	float scale;
+	uint8_t checks;
+	const bool *enabled;
+	const float *lo;
+	const float *hi;
+	const float *hst;
+};
+
+#define ALARM(_id, _name, _channel, _scale, _checks, _prefix)                                      \
+	[_id] = {                                                                                  \
+		.name = _name,                                                                     \
+		.channel = _channel,                                                               \
+		.scale = _scale,                                                                   \
+		.checks = _checks,                                                                 \
+		.enabled = &g_app_config._prefix##_enabled,                                        \
+		.lo = &g_app_config._prefix##_lo,                                                  \
+		.hi = &g_app_config._prefix##_hi,                                                  \
+		.hst = &g_app_config._prefix##_hst,                                                \
+	}
+
+/* Illuminance is not checked for being stuck (it stays at zero in the dark) */
+static const struct alarm m_alarms[] = {
+	ALARM(APP_ALARM_TEMPERATURE, "internal temperature", APP_HISTORY_CHANNEL_TEMPERATURE, 1.f,
+	      CHECK_ROC | CHECK_STUCK, alarm_temperature),
+	ALARM(APP_ALARM_HUMIDITY, "humidity", APP_HISTORY_CHANNEL_HUMIDITY, 1.f, CHECK_STUCK,
+	      alarm_humidity),
+	ALARM(APP_ALARM_PRESSURE, "pressure", APP_HISTORY_CHANNEL_PRESSURE, 10.f, CHECK_STUCK,
+	      alarm_pressure),
+	ALARM(APP_ALARM_T1_TEMPERATURE, "external temperature 1",
+	      APP_HISTORY_CHANNEL_T1_TEMPERATURE, 1.f, CHECK_ROC | CHECK_STUCK,
+	      alarm_t1_temperature),
+	ALARM(APP_ALARM_T2_TEMPERATURE, "external temperature 2",
+	      APP_HISTORY_CHANNEL_T2_TEMPERATURE, 1.f, CHECK_ROC | CHECK_STUCK,
+	      alarm_t2_temperature),
+	ALARM(APP_ALARM_ILLUMINANCE, "illuminance", APP_HISTORY_CHANNEL_ILLUMINANCE, 1.f, 0,
+	      alarm_illuminance),
+	ALARM(APP_ALARM_MP1_TEMPERATURE, "machine probe 1 temperature",
+	      APP_HISTORY_CHANNEL_MP1_TEMPERATURE, 1.f, CHECK_ROC | CHECK_STUCK,
+	      alarm_mp_temperature),
+	ALARM(APP_ALARM_MP2_TEMPERATURE, "machine probe 2 temperature",
+	      APP_HISTORY_CHANNEL_MP2_TEMPERATURE, 1.f, CHECK_ROC | CHECK_STUCK,
+	      alarm_mp_temperature),
+	ALARM(APP_ALARM_MP1_HUMIDITY, "machine probe 1 humidity", APP_HISTORY_CHANNEL_MP1_HUMIDITY,
+	      1.f, CHECK_STUCK, alarm_mp_humidity),
+	ALARM(APP_ALARM_MP2_HUMIDITY, "machine probe 2 humidity", APP_HISTORY_CHANNEL_MP2_HUMIDITY,
+	      1.f, CHECK_STUCK, alarm_mp_humidity),
+};
+
+/* Bit per enum app_alarm */
+static atomic_t m_state;
+
+/* Channels (bit per m_alarms entry) in rate-of-change and stuck sensor alarm */
+static uint32_t m_roc_state;
+static uint32_t m_stuck_state;
+
+/* Last reading and the number of samples it repeated for */
+static float m_stuck_value[ARRAY_SIZE(m_alarms)];
+static int m_stuck_count[ARRAY_SIZE(m_alarms)];
+
+/* Time at which the token bucket is full again */
+static int64_t m_notify_full_at;
+
+/* Take a token, returns milliseconds until one is available if the bucket is empty */
+static int64_t take_token(void)
 {
-	k_mutex_lock(&g_app_sensor_data_lock, K_FOREVER);
-
-	static bool alarm_temperature = false;
-
-	if (!g_app_config.alarm_temperature_enabled) {
-		alarm_temperature = false;
-	} else if (isnan(g_app_sensor_data.temperature)) {
-		alarm_temperature = false;
-	} else if (alarm_temperature) {
-		if (g_app_sensor_data.temperature > (g_app_config.alarm_temperature_lo +
-						     g_app_config.alarm_temperature_hst) &&
-		    g_app_sensor_data.temperature < (g_app_config.alarm_temperature_hi -
-						     g_app_config.alarm_temperature_hst)) {
-			LOG_INF("Deactivated alarm for internal temperature");
-
-			alarm_temperature = false;
-		}
-	} else {
-		if (g_app_sensor_data.temperature < (g_app_config.alarm_temperature_lo -
-						     g_app_config.alarm_temperature_hst) ||
-		    g_app_sensor_data.temperature > (g_app_config.alarm_temperature_hi +
-						     g_app_config.alarm_temperature_hst)) {
-			LOG_INF("Activated alarm for internal temperature");
+	int64_t now = k_uptime_get();
+	int64_t refill = NOTIFY_REFILL_MIN_SEC * 1000;
 
-			alarm_temperature = true;
-		}
+#if defined(CONFIG_LORAWAN)
+	/* Budgeted for the largest report the current data rate allows */
+	refill = MAX(refill, app_lrw_get_duty_cycle_msec(app_lrw_get_max_payload_size()));
+#endif /* defined(CONFIG_LORAWAN) */
+
+	int64_t full_at = MAX(m_notify_full_at, now);
+
+	/* Bucket holds fewer than one token */
+	if (full_at - now > (NOTIFY_BURST - 1) * refill) {
+		return full_at - now - (NOTIFY_BURST - 1) * refill;
 	}
 
-	static bool alarm_humidity = false;
+	m_notify_full_at = full_at + refill;
 
-	if (!g_app_config.alarm_humidity_enabled) {
-		alarm_humidity = false;
-	} else if (isnan(g_app_sensor_data.humidity)) {
-		alarm_humidity = false;
-	} else if (alarm_humidity) {
-		if (g_app_sensor_data.humidity >
-			    (g_app_config.alarm_humidity_lo + g_app_config.alarm_humidity_hst) &&
-		    g_app_sensor_data.humidity <
-			    (g_app_config.alarm_humidity_hi - g_app_config.alarm_humidity_hst)) {
-			LOG_INF("Deactivated alarm for humidity");
+	return 0;
+}
 
-			alarm_humidity = false;
-		}
-	} else {
-		if (g_app_sensor_data.humidity <
-			    (g_app_config.alarm_humidity_lo - g_app_config.alarm_humidity_hst) ||
-		    g_app_sensor_data.humidity >
-			    (g_app_config.alarm_humidity_hi + g_app_config.alarm_humidity_hst)) {
-			LOG_INF("Activated alarm for humidity");
+static void notify_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
 
-			alarm_humidity = true;
-		}
+	int64_t delay = take_token();
+	if (delay) {
+		LOG_WRN("Alarm uplink rate limited, postponed by %d ms", (int)delay);
+		k_work_schedule(dwork, K_MSEC(delay));
+		return;
 	}
 
-	static bool alarm_pressure = false;
+#if defined(CONFIG_LORAWAN)
+	app_lrw_send();
+#endif /* defined(CONFIG_LORAWAN) */
+}
 
-	if (!g_app_config.alarm_pressure_enabled) {
-		alarm_pressure = false;
-	} else if (isnan(g_app_sensor_data.pressure)) {
-		alarm_pressure = false;
-	} else if (alarm_pressure) {
-		if (g_app_sensor_data.pressure * 10.f >
-			    (g_app_config.alarm_pressure_lo + g_app_config.alarm_pressure_hst) &&
-		    g_app_sensor_data.pressure * 10.f <
-			    (g_app_config.alarm_pressure_hi - g_app_config.alarm_pressure_hst)) {
-			LOG_INF("Deactivated alarm for pressure");
+static K_WORK_DELAYABLE_DEFINE(m_notify_work, notify_work_handler);
 
-			alarm_pressure = false;
+static bool evaluate(const struct alarm *alarm, float value, bool is_active)
+{
+	if (!*alarm->enabled || isnan(value)) {
+		return false;
+	}
+
+	value *= alarm->scale;
+
+	/* Hysteresis: leave the alarm inside the narrowed band, enter it outside the widened one */
+	if (is_active) {
+		return !(value > *alarm->lo + *alarm->hst && value < *alarm->hi - *alarm->hst);
+	}
+
+	return value < *alarm->lo - *alarm->hst || value > *alarm->hi + *alarm->hst;
+}
+
+/* Temperature change in deg. C per minute over the rate-of-change window, NAN if unknown */
+static void get_rates(const struct app_history_sample *sample, float rates[ARRAY_SIZE(m_alarms)])
+{
+	uint32_t since = sample->timestamp - MIN(sample->timestamp, g_app_config.alarm_roc_window);
+
+	for (size_t i = 0; i < ARRAY_SIZE(m_alarms); i++) {
+		rates[i] = NAN;
+	}
+
+	if (!g_app_config.alarm_roc_enabled) {
+		return;
+	}
+
+	app_history_lock();
+
+	int count = app_history_get_count();
+
+	/* Oldest reading of each channel within the window */
+	for (int j = 0; j < count; j++) {
+		struct app_history_sample old;
+
+		if (app_history_get(j, &old) || old.timestamp < since) {
+			continue;
 		}
-	} else {
-		if (g_app_sensor_data.pressure * 10.f <
-			    (g_app_config.alarm_pressure_lo - g_app_config.alarm_pressure_hst) ||
-		    g_app_sensor_data.pressure * 10.f >
-			    (g_app_config.alarm_pressure_hi + g_app_config.alarm_pressure_hst)) {
-			LOG_INF("Activated alarm for pressure");
 
-			alarm_pressure = true;
+		/* At least a minute apart to not amplify the sensor noise */
+		if (sample->timestamp - old.timestamp < 60) {
+			break;
 		}
-	}
 
-	static bool alarm_t1_temperature = false;
+		for (size_t i = 0; i < ARRAY_SIZE(m_alarms); i++) {
+			enum app_history_channel channel = m_alarms[i].channel;
 
-	if (!g_app_config.alarm_t1_temperature_enabled) {
-		alarm_t1_temperature = false;
-	} else if (isnan(g_app_sensor_data.t1_temperature)) {
-		alarm_t1_temperature = false;
-	} else if (alarm_t1_temperature) {
-		if (g_app_sensor_data.t1_temperature > (g_app_config.alarm_t1_temperature_lo +
-							g_app_config.alarm_t1_temperature_hst) &&
-		    g_app_sensor_data.t1_temperature < (g_app_config.alarm_t1_temperature_hi -
-							g_app_config.alarm_t1_temperature_hst)) {
-			LOG_INF("Deactivated alarm for external temperature 1");
+			if (!(m_alarms[i].checks & CHECK_ROC) || !isnan(rates[i]) ||
+			    isnan(old.values[channel]) || isnan(sample->values[channel])) {
+				continue;
+			}
 
-			alarm_t1_temperature = false;
+			rates[i] = (sample->values[channel] - old.values[channel]) * 60.f /
+				   (sample->timestamp - old.timestamp);
 		}
+	}
+
+	app_history_unlock();
+}
+
+static bool evaluate_roc(float rate, bool is_active)
+{
+	if (!g_app_config.alarm_roc_enabled || isnan(rate)) {
+		return false;
+	}
+
+	/* Leave the alarm once the rate drops below half of the threshold */
+	return fabsf(rate) > (is_active ? 0.5f : 1.f) * g_app_config.alarm_roc_rate;
+}
+
+static bool evaluate_stuck(int index, float value)
+{
+	if (!g_app_config.alarm_stuck_enabled || isnan(value)) {
+		m_stuck_count[index] = 0;
+		return false;
+	}
+
+	if (m_stuck_count[index] && value == m_stuck_value[index]) {
+		m_stuck_count[index] = MIN(m_stuck_count[index] + 1, INT16_MAX);
 	} else {
-		if (g_app_sensor_data.t1_temperature < (g_app_config.alarm_t1_temperature_lo -
-							g_app_config.alarm_t1_temperature_hst) ||
-		    g_app_sensor_data.t1_temperature > (g_app_config.alarm_t1_temperature_hi +
-							g_app_config.alarm_t1_temperature_hst)) {
-			LOG_INF("Activated alarm for external temperature 1");
+		m_stuck_value[index] = value;
+		m_stuck_count[index] = 1;
+	}
 
-			alarm_t1_temperature = true;
-		}
+	return m_stuck_count[index] >= g_app_config.alarm_stuck_samples;
+}
+
+/* Update the channel bit, returns true on transition */
+static bool update(uint32_t *state, int bit, bool is_active, const char *kind, const char *name)
+{
+	bool was_active = *state & BIT(bit);
+
+	if (is_active == was_active) {
+		return false;
 	}
 
-	static bool alarm_t2_temperature = false;
+	if (is_active) {
+		LOG_INF("Activated %salarm for %s", kind, name);
+		*state |= BIT(bit);
+	} else {
+		LOG_INF("Deactivated %salarm for %s", kind, name);
+		*state &= ~BIT(bit);
+	}
+
+	return true;
+}
+
+void app_alarm_evaluate(const struct app_history_sample *sample)
+{
+	uint32_t state = atomic_get(&m_state);
+	bool is_any_active = state != 0;
+	uint32_t changed = 0;
+
+	float rates[ARRAY_SIZE(m_alarms)];
 
-	if (!g_app_config.alarm_t2_temperature_enabled) {
-		alarm_t2_temperature = false;
-	} else if (isnan(g_app_sensor_data.t2_temperature)) {
-		alarm_t2_temperature = false;
-	} else if (alarm_t2_temperature) {
-		if (g_app_sensor_data.t2_temperature > (g_app_config.alarm_t2_temperature_lo +
-							g_app_config.alarm_t2_temperature_hst) &&
-		    g_app_sensor_data.t2_temperature < (g_app_config.alarm_t2_temperature_hi -
-							g_app_config.alarm_t2_temperature_hst)) {
-			LOG_INF("Deactivated alarm for external temperature 2");
+	get_rates(sample, rates);
 
-			alarm_t2_temperature = false;
+	for (int i = 0; i < ARRAY_SIZE(m_alarms); i++) {
+		const struct alarm *alarm = &m_alarms[i];
+		float value = sample->values[alarm->channel];
+
+		if ((alarm->checks & CHECK_ROC) &&
+		    update(&m_roc_state, i, evaluate_roc(rates[i], m_roc_state & BIT(i)),
+			   "rate-of-change ", alarm->name)) {
+			changed |= BIT(APP_ALARM_RATE_OF_CHANGE);
 		}
-	} else {
-		if (g_app_sensor_data.t2_temperature < (g_app_config.alarm_t2_temperature_lo -
-							g_app_config.alarm_t2_temperature_hst) ||
-		    g_app_sensor_data.t2_temperature > (g_app_config.alarm_t2_temperature_hi +
-							g_app_config.alarm_t2_temperature_hst)) {
-			LOG_INF("Activated alarm for external temperature 2");
 
-			alarm_t2_temperature = true;
+		if ((alarm->checks & CHECK_STUCK) &&
+		    update(&m_stuck_state, i, evaluate_stuck(i, value), "stuck sensor ",
+			   alarm->name)) {
+			changed |= BIT(APP_ALARM_STUCK_SENSOR);
 		}
 	}
 
-	bool alarm = false;
+	state &= ~(BIT(APP_ALARM_RATE_OF_CHANGE) | BIT(APP_ALARM_STUCK_SENSOR));
+	state |= m_roc_state ? BIT(APP_ALARM_RATE_OF_CHANGE) : 0;
+	state |= m_stuck_state ? BIT(APP_ALARM_STUCK_SENSOR) : 0;
 
-	if (g_app_config.alarm_temperature_enabled) {
-		alarm = alarm_temperature ? true : alarm;
+	for (int i = 0; i < ARRAY_SIZE(m_alarms); i++) {
+		const struct alarm *alarm = &m_alarms[i];
+
+		bool was_active = state & BIT(i);
+		bool is_active = evaluate(alarm, sample->values[alarm->channel], was_active);
+
+		if (is_active && !was_active) {
+			LOG_INF("Activated alarm for %s", alarm->name);
+			state |= BIT(i);
+			changed |= BIT(i);
+		} else if (!is_active && was_active) {
+			LOG_INF("Deactivated alarm for %s", alarm->name);
+			state &= ~BIT(i);
+			changed |= BIT(i);
+		}
 	}
 
-	if (g_app_config.alarm_humidity_enabled) {
-		alarm = alarm_humidity ? true : alarm;
+	atomic_set(&m_state, state);
+
+	/* Start the LED indication without waiting for the stretched heartbeat */
+	if (state && !is_any_active) {
+		app_main_post(APP_MAIN_EVENT_ALARM);
 	}
 
-	if (g_app_config.alarm_pressure_enabled) {
-		alarm = alarm_pressure ? true : alarm;
+	/* Transitions within the same sample share one uplink */
+	if (changed && g_app_config.alarm_notify) {
+		k_work_schedule(&m_notify_work, K_NO_WAIT);
 	}
+}
 
-	if (g_app_config.alarm_t1_temperature_enabled) {
-		alarm = alarm_t1_temperature ? true : alarm;
+uint32_t app_alarm_get_state(void)
+{
+	return atomic_get(&m_state);
+}
+
+bool app_alarm_is_enabled(void)
+{
+	if (g_app_config.alarm_roc_enabled || g_app_config.alarm_stuck_enabled) {
+		return true;
 	}
 
-	if (g_app_config.alarm_t2_temperature_enabled) {
-		alarm = alarm_t2_temperature ? true : alarm;
+	for (int i = 0; i < ARRAY_SIZE(m_alarms); i++) {
+		if (*m_alarms[i].enabled) {
+			return true;
+		}
 	}
 
-	k_mutex_unlock(&g_app_sensor_data_lock);
+	return false;
+}
 
-	return alarm;
+bool app_alarm_is_active(void)
+{
+	return atomic_get(&m_state) != 0;
 }
@@ -7,13 +7,39 @@
 #ifndef APP_ALARM_H_
 #define APP_ALARM_H_
 
+#include "app_history.h"
+
 /* Standard includes */
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Bit positions in the alarm state */
+enum app_alarm {
+	APP_ALARM_TEMPERATURE = 0,
+	APP_ALARM_HUMIDITY = 1,
+	APP_ALARM_PRESSURE = 2,
+	APP_ALARM_T1_TEMPERATURE = 3,
+	APP_ALARM_T2_TEMPERATURE = 4,
+	APP_ALARM_ILLUMINANCE = 5,
+	APP_ALARM_MP1_TEMPERATURE = 6,
+	APP_ALARM_MP2_TEMPERATURE = 7,
+	APP_ALARM_MP1_HUMIDITY = 8,
+	APP_ALARM_MP2_HUMIDITY = 9,
+	/* Any temperature changing faster than alarm-roc-rate */
+	APP_ALARM_RATE_OF_CHANGE = 10,
+	/* Any reading unchanged for alarm-stuck-samples samples */
+	APP_ALARM_STUCK_SENSOR = 11,
+	APP_ALARM_COUNT = 12,
+};
+
+/* Update the alarm state from a new sample */
+void app_alarm_evaluate(const struct app_history_sample *sample);
+uint32_t app_alarm_get_state(void);
+bool app_alarm_is_enabled(void);
 bool app_alarm_is_active(void);
 
 #ifdef __cplusplus
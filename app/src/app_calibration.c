@@ -65,6 +65,11 @@ static bool read_hall_gpio(bool *out_left, bool *out_right)
 		GPIO_DT_SPEC_GET(DT_ALIAS(sw0), gpios),
 		GPIO_DT_SPEC_GET(DT_ALIAS(sw1), gpios),
 	};
+	/* Switches read on interrupt by app_hall rely on a permanent pull-up */
+	const bool is_interrupt[] = {
+		g_app_config.cap_hall_left && g_app_config.hall_left_interrupt,
+		g_app_config.cap_hall_right && g_app_config.hall_right_interrupt,
+	};
 	bool active[ARRAY_SIZE(halls)] = {false};
 
 	for (int i = 0; i < ARRAY_SIZE(halls); i++) {
@@ -83,7 +88,9 @@ static bool read_hall_gpio(bool *out_left, bool *out_right)
 			active[i] = val;
 		}
 
-		gpio_pin_configure_dt(&halls[i], GPIO_INPUT | GPIO_PULL_DOWN);
+		gpio_flags_t pull = is_interrupt[i] ? GPIO_PULL_UP : GPIO_PULL_DOWN;
+
+		gpio_pin_configure_dt(&halls[i], GPIO_INPUT | pull);
 	}
 
 	if (out_left) {
@@ -262,8 +269,7 @@ int app_calibration_init(void)
 
 	/* Init DS18B20 sensors */
 	if (w1_ready && g_app_config.cap_1w_thermometer) {
-		device_init(DEVICE_DT_GET(DT_NODELABEL(ds18b20_0)));
-		device_init(DEVICE_DT_GET(DT_NODELABEL(ds18b20_1)));
+		device_init(DEVICE_DT_GET(DT_NODELABEL(ds18b20)));
 
 		if (!app_ds18b20_scan()) {
 			m_count_ds18b20 = app_ds18b20_get_count();
@@ -272,8 +278,7 @@ int app_calibration_init(void)
 
 	/* Init Machine Probe sensors */
 	if (w1_ready && g_app_config.cap_1w_machine_probe) {
-		device_init(DEVICE_DT_GET(DT_NODELABEL(machine_probe_0)));
-		device_init(DEVICE_DT_GET(DT_NODELABEL(machine_probe_1)));
+		device_init(DEVICE_DT_GET(DT_NODELABEL(machine_probe)));
 
 		if (!app_machine_probe_scan()) {
 			m_count_machine_probe = app_machine_probe_get_count();
@@ -5,25 +5,700 @@
  */
 
 #include "app_compose.h"
+#include "app_alarm.h"
+#include "app_config.h"
 #include "app_hall.h"
+#include "app_history.h"
 #include "app_input.h"
 #include "app_sensor.h"
+#include "app_w1.h"
 
 /* Zephyr includes */
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/net_buf.h>
+#include <zephyr/sys/util.h>
 
 /* Standard includes */
+#include <errno.h>
 #include <limits.h>
 #include <math.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 LOG_MODULE_REGISTER(app_compose, LOG_LEVEL_DBG);
 
-int app_compose(uint8_t *buf, size_t size, size_t *len)
+/* Extension records follow the fixed fields: tag (u8), length (u8) and data */
+#define EXT_TAG_AGGREG      0x01
+#define EXT_TAG_BATCH       0x02
+#define EXT_TAG_BATCH_DELTA 0x03
+#define EXT_TAG_PULSE       0x04
+#define EXT_TAG_ALARM       0x05
+#define EXT_TAG_W1_TOPOLOGY 0x06
+#define EXT_TAG_T_PROBES    0x07
+#define EXT_TAG_MP_PROBES   0x08
+#define EXT_TAG_COUNTERS    0x09
+
+/* Probe slots carried by the fixed fields (T1/T2 and MP1/MP2) */
+#define FIXED_PROBE_COUNT 2
+
+#define AGGREG_MAX_WINDOWS 8
+
+/* Compressed reports between the full counter values (bounds the loss of a missed uplink) */
+#define COUNTER_KEYFRAME_INTERVAL 12
+
+/* Counters sent as deltas in compressed reports (bit position in counter mask) */
+enum counter {
+	COUNTER_MOTION = 0,
+	COUNTER_HALL_LEFT,
+	COUNTER_HALL_RIGHT,
+	COUNTER_INPUT_A,
+	COUNTER_INPUT_B,
+	COUNTER_COUNT,
+};
+
+static const uint32_t m_counter_bits[] = {
+	[COUNTER_MOTION] = BIT(23),
+	[COUNTER_HALL_LEFT] = BIT(13),
+	[COUNTER_HALL_RIGHT] = BIT(12),
+	[COUNTER_INPUT_A] = BIT(5),
+	[COUNTER_INPUT_B] = BIT(4),
+};
+
+/* Counter values of the previous report and the number of reports since the full values */
+static uint32_t m_last_counters[COUNTER_COUNT];
+static int m_counter_reports;
+
+/* End of the last reported aggregation window and timestamp of the last batched sample */
+static uint32_t m_aggreg_until;
+static uint32_t m_batch_timestamp;
+
+/* State of the last composed report, applied by app_compose_commit() */
+static struct {
+	uint32_t counters[COUNTER_COUNT];
+	int counter_reports;
+	bool is_counter_baseline;
+	uint32_t aggreg_until;
+	uint32_t batch_timestamp;
+	struct app_input_data input_data;
+	bool is_pulse;
+} m_pending;
+
+/* Fixed fields in order of dropping when the payload size is limited (least important first) */
+static const struct {
+	uint32_t bit;
+	size_t size;
+} m_fields[] = {
+	{BIT(21), 4}, /* Pressure */
+	{BIT(22), 2}, /* Altitude */
+	{BIT(16), 1}, /* Machine probe 2 humidity */
+	{BIT(17), 1}, /* Machine probe 1 humidity */
+	{BIT(26), 2}, /* Illuminance */
+	{BIT(23), 4}, /* Motion count */
+	{BIT(24), 2}, /* T2 temperature */
+	{BIT(25), 2}, /* T1 temperature */
+	{BIT(18), 2}, /* Machine probe 2 temperature */
+	{BIT(19), 2}, /* Machine probe 1 temperature */
+	{BIT(27), 1}, /* Humidity */
+	{BIT(29), 1}, /* Voltage */
+	{BIT(28), 2}, /* Temperature */
+	{BIT(12), 4}, /* Hall right count */
+	{BIT(13), 4}, /* Hall left count */
+	{BIT(4), 5},  /* Input B count and status */
+	{BIT(5), 5},  /* Input A count and status */
+};
+
+/* Clear header bits of the least important fields until the payload fits */
+static uint32_t fit_fields(uint32_t header, size_t size)
+{
+	size_t total = 4;
+
+	for (size_t i = 0; i < ARRAY_SIZE(m_fields); i++) {
+		if (header & m_fields[i].bit) {
+			total += m_fields[i].size;
+		}
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(m_fields) && total > size; i++) {
+		if (header & m_fields[i].bit) {
+			header &= ~m_fields[i].bit;
+			total -= m_fields[i].size;
+		}
+	}
+
+	return header;
+}
+
+static size_t get_channel_size(enum app_history_channel channel)
+{
+	switch (channel) {
+	case APP_HISTORY_CHANNEL_VOLTAGE:
+	case APP_HISTORY_CHANNEL_HUMIDITY:
+	case APP_HISTORY_CHANNEL_MP1_HUMIDITY:
+	case APP_HISTORY_CHANNEL_MP2_HUMIDITY:
+		return 1;
+	case APP_HISTORY_CHANNEL_PRESSURE:
+		return 4;
+	default:
+		return 2;
+	}
+}
+
+/* Channel value in the same encoding as the fixed fields (including invalid value markers) */
+static int64_t get_channel_code(enum app_history_channel channel, float value)
+{
+	switch (channel) {
+	case APP_HISTORY_CHANNEL_VOLTAGE:
+		return isnan(value) ? 0xff : (uint8_t)CLAMP(value * 50, 0, 255);
+	case APP_HISTORY_CHANNEL_HUMIDITY:
+	case APP_HISTORY_CHANNEL_MP1_HUMIDITY:
+	case APP_HISTORY_CHANNEL_MP2_HUMIDITY:
+		return isnan(value) ? 0xff : (uint8_t)(value * 2);
+	case APP_HISTORY_CHANNEL_ILLUMINANCE:
+		return isnan(value) ? 0xffff : (uint16_t)(value / 2);
+	case APP_HISTORY_CHANNEL_ALTITUDE:
+		return isnan(value) ? 0x7fff : (int16_t)CLAMP(value * 10, INT16_MIN, INT16_MAX);
+	case APP_HISTORY_CHANNEL_PRESSURE:
+		return isnan(value) ? 0xffffffff : (uint32_t)(value * 1000.f);
+	default:
+		return isnan(value) ? 0x7fff : (int16_t)(value * 100);
+	}
+}
+
+static void add_channel(struct net_buf_simple *nbuf, enum app_history_channel channel, float value)
+{
+	int64_t code = get_channel_code(channel, value);
+
+	switch (get_channel_size(channel)) {
+	case 1:
+		net_buf_simple_add_u8(nbuf, (uint8_t)code);
+		break;
+	case 2:
+		net_buf_simple_add_be16(nbuf, (uint16_t)code);
+		break;
+	default:
+		net_buf_simple_add_be32(nbuf, (uint32_t)code);
+		break;
+	}
+}
+
+/* Zig-zag mapping of signed deltas, so that small magnitudes produce short varints */
+static uint64_t zigzag(int64_t value)
+{
+	return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static size_t get_varint_size(uint64_t value)
+{
+	size_t size = 1;
+
+	while (value >= 0x80) {
+		value >>= 7;
+		size++;
+	}
+
+	return size;
+}
+
+/* Unsigned LEB128 varint (7 bits per byte, least significant group first) */
+static void add_varint(struct net_buf_simple *nbuf, uint64_t value)
+{
+	while (value >= 0x80) {
+		net_buf_simple_add_u8(nbuf, (uint8_t)(value | 0x80));
+		value >>= 7;
+	}
+
+	net_buf_simple_add_u8(nbuf, (uint8_t)value);
+}
+
+/* Size of a compressed sample encoded as delta to the previous sample */
+static size_t get_delta_size(const struct app_history_sample *prev,
+			     const struct app_history_sample *sample, uint16_t mask)
+{
+	size_t size = get_varint_size(sample->timestamp - prev->timestamp);
+
+	for (int i = 0; i < APP_HISTORY_CHANNEL_COUNT; i++) {
+		if (mask & BIT(i)) {
+			size += get_varint_size(zigzag(get_channel_code(i, sample->values[i]) -
+						       get_channel_code(i, prev->values[i])));
+		}
+	}
+
+	return size;
+}
+
+static void add_delta(struct net_buf_simple *nbuf, const struct app_history_sample *prev,
+		      const struct app_history_sample *sample, uint16_t mask)
+{
+	add_varint(nbuf, sample->timestamp - prev->timestamp);
+
+	for (int i = 0; i < APP_HISTORY_CHANNEL_COUNT; i++) {
+		if (mask & BIT(i)) {
+			add_varint(nbuf, zigzag(get_channel_code(i, sample->values[i]) -
+						get_channel_code(i, prev->values[i])));
+		}
+	}
+}
+
+static bool is_input_counter(enum counter counter)
+{
+	return counter == COUNTER_INPUT_A || counter == COUNTER_INPUT_B;
+}
+
+/* Input status byte: bit 3=notify_act, bit 2=notify_deact, bit 1=reserved, bit 0=is_active */
+static uint8_t get_input_status(bool notify_act, bool notify_deact, bool is_active)
+{
+	uint8_t status = 0;
+
+	if (notify_act) {
+		status |= BIT(3);
+	}
+
+	if (notify_deact) {
+		status |= BIT(2);
+	}
+
+	if (is_active) {
+		status |= BIT(0);
+	}
+
+	return status;
+}
+
+static int64_t get_counter_delta(const uint32_t *counters, enum counter counter)
+{
+	/* Modulo 2^32, so that a wrapped counter still yields a small delta */
+	return (int32_t)(counters[counter] - m_last_counters[counter]);
+}
+
+/* Size of the counter record data: counter mask (u8), then zig-zag varint delta to the previous
+ * report per counter (followed by the status byte for inputs) */
+static size_t get_counters_size(const uint32_t *counters, uint8_t mask)
+{
+	size_t size = 1;
+
+	for (int i = 0; i < COUNTER_COUNT; i++) {
+		if (mask & BIT(i)) {
+			size += get_varint_size(zigzag(get_counter_delta(counters, i)));
+			size += is_input_counter(i) ? 1 : 0;
+		}
+	}
+
+	return size;
+}
+
+static void compose_counters(struct net_buf_simple *nbuf, const uint32_t *counters,
+			     const uint8_t *input_status, uint8_t mask)
+{
+	net_buf_simple_add_u8(nbuf, EXT_TAG_COUNTERS);
+	net_buf_simple_add_u8(nbuf, get_counters_size(counters, mask));
+	net_buf_simple_add_u8(nbuf, mask);
+
+	for (int i = 0; i < COUNTER_COUNT; i++) {
+		if (!(mask & BIT(i))) {
+			continue;
+		}
+
+		add_varint(nbuf, zigzag(get_counter_delta(counters, i)));
+
+		if (is_input_counter(i)) {
+			net_buf_simple_add_u8(nbuf, input_status[i - COUNTER_INPUT_A]);
+		}
+	}
+}
+
+/* Append the state of all alarms (bit per enum app_alarm) if any alarm is enabled */
+static void compose_alarm(struct net_buf_simple *nbuf)
+{
+	if (!app_alarm_is_enabled()) {
+		return;
+	}
+
+	if (net_buf_simple_tailroom(nbuf) < 2 + 2) {
+		LOG_WRN("No room for alarm record");
+		return;
+	}
+
+	net_buf_simple_add_u8(nbuf, EXT_TAG_ALARM);
+	net_buf_simple_add_u8(nbuf, 2);
+	net_buf_simple_add_be16(nbuf, (uint16_t)app_alarm_get_state());
+}
+
+/* Append the number of 1-Wire devices once the bus topology changed */
+static void compose_w1_topology(struct net_buf_simple *nbuf)
+{
+	if (net_buf_simple_tailroom(nbuf) < 2 + 1) {
+		LOG_WRN("No room for 1-Wire topology record");
+		return;
+	}
+
+	if (!app_w1_is_topology_changed(true)) {
+		return;
+	}
+
+	net_buf_simple_add_u8(nbuf, EXT_TAG_W1_TOPOLOGY);
+	net_buf_simple_add_u8(nbuf, 1);
+	net_buf_simple_add_u8(nbuf, MIN(app_w1_get_device_count(), UINT8_MAX));
+}
+
+/* Append the thermometers beyond T2: slot mask (u8), then temperature (be16) per slot */
+static void compose_t_probes(struct net_buf_simple *nbuf)
+{
+	uint8_t mask = 0;
+	int16_t temperatures[CONFIG_APP_DS18B20_COUNT];
+
+	k_mutex_lock(&g_app_sensor_data_lock, K_FOREVER);
+
+	for (int i = FIXED_PROBE_COUNT; i < CONFIG_APP_DS18B20_COUNT; i++) {
+		if (!isnan(g_app_sensor_data.t_temperature[i])) {
+			temperatures[i] = (int16_t)(g_app_sensor_data.t_temperature[i] * 100);
+			mask |= BIT(i);
+		}
+	}
+
+	k_mutex_unlock(&g_app_sensor_data_lock);
+
+	if (!mask) {
+		return;
+	}
+
+	size_t size = 1 + POPCOUNT(mask) * 2;
+
+	if (net_buf_simple_tailroom(nbuf) < 2 + size) {
+		LOG_WRN("No room for thermometer record");
+		return;
+	}
+
+	net_buf_simple_add_u8(nbuf, EXT_TAG_T_PROBES);
+	net_buf_simple_add_u8(nbuf, size);
+	net_buf_simple_add_u8(nbuf, mask);
+
+	for (int i = FIXED_PROBE_COUNT; i < CONFIG_APP_DS18B20_COUNT; i++) {
+		if (mask & BIT(i)) {
+			net_buf_simple_add_be16(nbuf, (uint16_t)temperatures[i]);
+		}
+	}
+}
+
+/* Append the machine probes beyond MP2: slot mask (u8) and tilt alert mask (u8), then
+ * temperature (be16) and humidity (u8) per slot */
+static void compose_mp_probes(struct net_buf_simple *nbuf)
+{
+	uint8_t mask = 0;
+	uint8_t tilt_mask = 0;
+	int16_t temperatures[CONFIG_APP_MACHINE_PROBE_COUNT];
+	uint8_t humidities[CONFIG_APP_MACHINE_PROBE_COUNT];
+
+	k_mutex_lock(&g_app_sensor_data_lock, K_FOREVER);
+
+	for (int i = FIXED_PROBE_COUNT; i < CONFIG_APP_MACHINE_PROBE_COUNT; i++) {
+		if (g_app_sensor_data.mp_is_tilt_alert[i]) {
+			tilt_mask |= BIT(i);
+		}
+
+		if (isnan(g_app_sensor_data.mp_temperature[i])) {
+			continue;
+		}
+
+		temperatures[i] = (int16_t)(g_app_sensor_data.mp_temperature[i] * 100);
+		humidities[i] = 0xff;
+
+		if (!isnan(g_app_sensor_data.mp_humidity[i])) {
+			humidities[i] = (uint8_t)(g_app_sensor_data.mp_humidity[i] * 2);
+		}
+
+		mask |= BIT(i);
+	}
+
+	k_mutex_unlock(&g_app_sensor_data_lock);
+
+	if (!mask && !tilt_mask) {
+		return;
+	}
+
+	size_t size = 2 + POPCOUNT(mask) * 3;
+
+	if (net_buf_simple_tailroom(nbuf) < 2 + size) {
+		LOG_WRN("No room for machine probe record");
+		return;
+	}
+
+	net_buf_simple_add_u8(nbuf, EXT_TAG_MP_PROBES);
+	net_buf_simple_add_u8(nbuf, size);
+	net_buf_simple_add_u8(nbuf, mask);
+	net_buf_simple_add_u8(nbuf, tilt_mask);
+
+	for (int i = FIXED_PROBE_COUNT; i < CONFIG_APP_MACHINE_PROBE_COUNT; i++) {
+		if (mask & BIT(i)) {
+			net_buf_simple_add_be16(nbuf, (uint16_t)temperatures[i]);
+			net_buf_simple_add_u8(nbuf, humidities[i]);
+		}
+	}
+}
+
+/* Append pulse count and min/max pulse period of the inputs counted on interrupt, returns
+ * whether the statistics are done with (reported or not reported at all) */
+static bool compose_pulse(struct net_buf_simple *nbuf, const struct app_input_data *data)
+{
+	uint8_t mask = 0;
+
+	if (g_app_config.cap_input_a && g_app_config.input_a_interrupt) {
+		mask |= BIT(0);
+	}
+
+	if (g_app_config.cap_input_b && g_app_config.input_b_interrupt) {
+		mask |= BIT(1);
+	}
+
+	/* Statistics not reported are not kept for later */
+	if (!mask) {
+		return true;
+	}
+
+	/* Channel mask (u8) and interval (be32), then pulses and min/max period (be32 each) */
+	size_t size = 5 + POPCOUNT(mask) * 12;
+
+	if (net_buf_simple_tailroom(nbuf) < 2 + size) {
+		LOG_WRN("No room for pulse record");
+		return false;
+	}
+
+	net_buf_simple_add_u8(nbuf, EXT_TAG_PULSE);
+	net_buf_simple_add_u8(nbuf, size);
+	net_buf_simple_add_u8(nbuf, mask);
+	net_buf_simple_add_be32(nbuf, data->pulse_interval);
+
+	if (mask & BIT(0)) {
+		net_buf_simple_add_be32(nbuf, data->input_a_pulses);
+		net_buf_simple_add_be32(nbuf, data->input_a_period_min);
+		net_buf_simple_add_be32(nbuf, data->input_a_period_max);
+	}
+
+	if (mask & BIT(1)) {
+		net_buf_simple_add_be32(nbuf, data->input_b_pulses);
+		net_buf_simple_add_be32(nbuf, data->input_b_period_min);
+		net_buf_simple_add_be32(nbuf, data->input_b_period_max);
+	}
+
+	return true;
+}
+
+/* Append min/max/mean/last of every aggregation window elapsed since the previous report,
+ * returns the end of the last appended window */
+static uint32_t compose_aggreg(struct net_buf_simple *nbuf)
+{
+	uint32_t interval = g_app_config.interval_aggreg;
+
+	if (!interval) {
+		return m_aggreg_until;
+	}
+
+	uint32_t until = (uint32_t)(k_uptime_get() / 1000);
+
+	int windows = CLAMP(DIV_ROUND_UP(until - m_aggreg_until, interval), 1, AGGREG_MAX_WINDOWS);
+
+	struct app_history_stats stats[APP_HISTORY_CHANNEL_COUNT];
+
+	uint32_t since = until > windows * interval ? until - windows * interval : 0;
+
+	if (!app_history_aggregate(since, until, stats)) {
+		LOG_WRN("No samples to aggregate");
+		return m_aggreg_until;
+	}
+
+	uint16_t mask = 0;
+	size_t window_size = 0;
+
+	for (int i = 0; i < APP_HISTORY_CHANNEL_COUNT; i++) {
+		if (stats[i].count) {
+			mask |= BIT(i);
+			window_size += 4 * get_channel_size(i);
+		}
+	}
+
+	if (!mask) {
+		LOG_WRN("No valid samples to aggregate");
+		return m_aggreg_until;
+	}
+
+	/* Interval (be32), window count (u8) and channel mask (be16) */
+	size_t head_size = 7;
+	size_t tailroom = net_buf_simple_tailroom(nbuf);
+
+	if (tailroom < 2 + head_size + window_size) {
+		LOG_WRN("No room for aggregation record");
+		return m_aggreg_until;
+	}
+
+	/* Drop the oldest windows which do not fit */
+	windows = MIN(windows, (int)((tailroom - 2 - head_size) / window_size));
+	windows = MIN(windows, (int)((UINT8_MAX - head_size) / window_size));
+
+	net_buf_simple_add_u8(nbuf, EXT_TAG_AGGREG);
+	net_buf_simple_add_u8(nbuf, head_size + windows * window_size);
+	net_buf_simple_add_be32(nbuf, interval);
+	net_buf_simple_add_u8(nbuf, windows);
+	net_buf_simple_add_be16(nbuf, mask);
+
+	/* Oldest window first */
+	for (int w = windows - 1; w >= 0; w--) {
+		uint32_t to = until - w * interval;
+		uint32_t from = to > interval ? to - interval : 0;
+
+		app_history_aggregate(from, to, stats);
+
+		for (int i = 0; i < APP_HISTORY_CHANNEL_COUNT; i++) {
+			if (!(mask & BIT(i))) {
+				continue;
+			}
+
+			add_channel(nbuf, i, stats[i].min);
+			add_channel(nbuf, i, stats[i].max);
+			add_channel(nbuf, i, stats[i].mean);
+			add_channel(nbuf, i, stats[i].last);
+		}
+	}
+
+	LOG_DBG("Aggregated %d window(s), channel mask: 0x%04x", windows, mask);
+
+	return until;
+}
+
+/* Append samples taken since the previous report, as many of the newest as fit, returns the
+ * timestamp of the newest appended sample */
+static uint32_t compose_batch(struct net_buf_simple *nbuf)
+{
+	if (!g_app_config.report_batch) {
+		return m_batch_timestamp;
+	}
+
+	bool compress = g_app_config.report_compress;
+
+	struct app_history_sample sample;
+	struct app_history_sample prev;
+
+	app_history_lock();
+
+	int count = app_history_get_count();
+	int first = count;
+	uint16_t mask = 0;
+
+	/* Collect channels of all pending samples */
+	for (int i = count - 1; i >= 0; i--) {
+		if (app_history_get(i, &sample) || sample.timestamp <= m_batch_timestamp) {
+			break;
+		}
+
+		for (int j = 0; j < APP_HISTORY_CHANNEL_COUNT; j++) {
+			if (!isnan(sample.values[j])) {
+				mask |= BIT(j);
+			}
+		}
+
+		first = i;
+	}
+
+	if (first == count) {
+		app_history_unlock();
+		LOG_DBG("No samples to batch");
+		return m_batch_timestamp;
+	}
+
+	size_t values_size = 0;
+
+	for (int i = 0; i < APP_HISTORY_CHANNEL_COUNT; i++) {
+		if (mask & BIT(i)) {
+			values_size += get_channel_size(i);
+		}
+	}
+
+	/* Age of the oldest sample (be32), sample count (u8) and channel mask (be16) */
+	size_t head_size = 7;
+	size_t tailroom = net_buf_simple_tailroom(nbuf);
+
+	/* Plain samples are prefixed by delta to the previous sample (be16) */
+	size_t sample_size = compress ? values_size : 2 + values_size;
+
+	if (tailroom < 2 + head_size + sample_size) {
+		app_history_unlock();
+		LOG_WRN("No room for batch record");
+		return m_batch_timestamp;
+	}
+
+	size_t limit = MIN(tailroom - 2, UINT8_MAX) - head_size;
+	size_t size;
+
+	if (compress) {
+		/* Keyframe is the oldest sample, the others are zig-zag varint deltas to the
+		 * previous one, so extend backwards from the newest sample while they fit */
+		app_history_get(count - 1, &sample);
+
+		size = values_size;
+
+		int i;
+
+		for (i = count - 1; i > first; i--) {
+			app_history_get(i - 1, &prev);
+
+			size_t delta_size = get_delta_size(&prev, &sample, mask);
+
+			if (size + delta_size > limit) {
+				break;
+			}
+
+			size += delta_size;
+			sample = prev;
+		}
+
+		first = i;
+	} else {
+		/* Skip the oldest samples which do not fit */
+		first = MAX(first, count - (int)(limit / sample_size));
+		size = (count - first) * sample_size;
+	}
+
+	uint32_t now = (uint32_t)(k_uptime_get() / 1000);
+
+	app_history_get(first, &prev);
+
+	net_buf_simple_add_u8(nbuf, compress ? EXT_TAG_BATCH_DELTA : EXT_TAG_BATCH);
+	net_buf_simple_add_u8(nbuf, head_size + size);
+	net_buf_simple_add_be32(nbuf, now - prev.timestamp);
+	net_buf_simple_add_u8(nbuf, count - first);
+	net_buf_simple_add_be16(nbuf, mask);
+
+	for (int i = first; i < count; i++) {
+		app_history_get(i, &sample);
+
+		if (compress && i != first) {
+			add_delta(nbuf, &prev, &sample, mask);
+		} else {
+			if (!compress) {
+				net_buf_simple_add_be16(nbuf, MIN(sample.timestamp - prev.timestamp,
+								  UINT16_MAX));
+			}
+
+			for (int j = 0; j < APP_HISTORY_CHANNEL_COUNT; j++) {
+				if (mask & BIT(j)) {
+					add_channel(nbuf, j, sample.values[j]);
+				}
+			}
+		}
+
+		prev = sample;
+	}
+
+	app_history_unlock();
+
+	LOG_DBG("Batched %d sample(s) in %zu byte(s), channel mask: 0x%04x", count - first,
+		size, mask);
+
+	return prev.timestamp;
+}
+
+int app_compose(uint8_t *buf, size_t size, size_t *len, bool is_queued)
 {
 	static bool boot = true;
 
@@ -94,13 +769,13 @@ int app_compose(uint8_t *buf, size_t size, size_t *len)
 		header |= BIT(26);
 	}
 
-	if (!isnan(g_app_sensor_data.t1_temperature)) {
-		t1_temperature = (int16_t)(g_app_sensor_data.t1_temperature * 100);
+	if (!isnan(g_app_sensor_data.t_temperature[0])) {
+		t1_temperature = (int16_t)(g_app_sensor_data.t_temperature[0] * 100);
 		header |= BIT(25);
 	}
 
-	if (!isnan(g_app_sensor_data.t2_temperature)) {
-		t2_temperature = (int16_t)(g_app_sensor_data.t2_temperature * 100);
+	if (!isnan(g_app_sensor_data.t_temperature[1])) {
+		t2_temperature = (int16_t)(g_app_sensor_data.t_temperature[1] * 100);
 		header |= BIT(24);
 	}
 
@@ -127,31 +802,31 @@ int app_compose(uint8_t *buf, size_t size, size_t *len)
 		header |= BIT(21);
 	}
 
-	if (!isnan(g_app_sensor_data.mp1_temperature)) {
-		mp1_temperature = (int16_t)(g_app_sensor_data.mp1_temperature * 100);
+	if (!isnan(g_app_sensor_data.mp_temperature[0])) {
+		mp1_temperature = (int16_t)(g_app_sensor_data.mp_temperature[0] * 100);
 		header |= BIT(19);
 	}
 
-	if (!isnan(g_app_sensor_data.mp2_temperature)) {
-		mp2_temperature = (int16_t)(g_app_sensor_data.mp2_temperature * 100);
+	if (!isnan(g_app_sensor_data.mp_temperature[1])) {
+		mp2_temperature = (int16_t)(g_app_sensor_data.mp_temperature[1] * 100);
 		header |= BIT(18);
 	}
 
-	if (!isnan(g_app_sensor_data.mp1_humidity)) {
-		mp1_humidity = (uint8_t)(g_app_sensor_data.mp1_humidity * 2);
+	if (!isnan(g_app_sensor_data.mp_humidity[0])) {
+		mp1_humidity = (uint8_t)(g_app_sensor_data.mp_humidity[0] * 2);
 		header |= BIT(17);
 	}
 
-	if (!isnan(g_app_sensor_data.mp2_humidity)) {
-		mp2_humidity = (uint8_t)(g_app_sensor_data.mp2_humidity * 2);
+	if (!isnan(g_app_sensor_data.mp_humidity[1])) {
+		mp2_humidity = (uint8_t)(g_app_sensor_data.mp_humidity[1] * 2);
 		header |= BIT(16);
 	}
 
-	if (g_app_sensor_data.mp1_is_tilt_alert) {
+	if (g_app_sensor_data.mp_is_tilt_alert[0]) {
 		header |= BIT(15);
 	}
 
-	if (g_app_sensor_data.mp2_is_tilt_alert) {
+	if (g_app_sensor_data.mp_is_tilt_alert[1]) {
 		header |= BIT(14);
 	}
 
@@ -203,6 +878,75 @@ int app_compose(uint8_t *buf, size_t size, size_t *len)
 
 	header |= orientation;
 
+	if (size < 4) {
+		LOG_ERR("Payload size too small: %zu byte(s)", size);
+		return -ENOSPC;
+	}
+
+	uint32_t counters[] = {
+		[COUNTER_MOTION] = motion_count,
+		[COUNTER_HALL_LEFT] = hall_left_count,
+		[COUNTER_HALL_RIGHT] = hall_right_count,
+		[COUNTER_INPUT_A] = input_a_count,
+		[COUNTER_INPUT_B] = input_b_count,
+	};
+
+	uint8_t input_status[] = {
+		get_input_status(input_data.input_a_notify_act, input_data.input_a_notify_deact,
+				 input_data.input_a_is_active),
+		get_input_status(input_data.input_b_notify_act, input_data.input_b_notify_deact,
+				 input_data.input_b_is_active),
+	};
+
+	/* Compressed reports carry the counters as deltas to the previous report instead (queued
+	 * reports are delivered out of order, so they always carry the full values) */
+	bool is_counter_delta = !is_queued && g_app_config.report_compress &&
+				m_counter_reports > 0 &&
+				m_counter_reports < COUNTER_KEYFRAME_INTERVAL;
+
+	uint8_t counter_mask = 0;
+	size_t counter_size = 0;
+
+	if (is_counter_delta) {
+		/* Omitted counters did not change, inputs with status are always included */
+		for (int i = 0; i < COUNTER_COUNT; i++) {
+			if (get_counter_delta(counters, i) ||
+			    (is_input_counter(i) && (header & m_counter_bits[i]))) {
+				counter_mask |= BIT(i);
+			}
+		}
+
+		counter_size = 2 + get_counters_size(counters, counter_mask);
+
+		if (size < 4 + counter_size) {
+			LOG_WRN("No room for counter record");
+			is_counter_delta = false;
+			counter_size = 0;
+		}
+	}
+
+	if (is_counter_delta) {
+		for (int i = 0; i < COUNTER_COUNT; i++) {
+			header &= ~m_counter_bits[i];
+		}
+	}
+
+	uint32_t fitted = fit_fields(header, size - counter_size);
+	bool is_counter_dropped = false;
+
+	if (fitted != header) {
+		LOG_WRN("Dropped fields (payload size: %zu byte(s)): 0x%08x", size,
+			header & ~fitted);
+
+		for (int i = 0; i < COUNTER_COUNT; i++) {
+			if (header & ~fitted & m_counter_bits[i]) {
+				is_counter_dropped = true;
+			}
+		}
+
+		header = fitted;
+	}
+
 	LOG_DBG("Header: 0x%08x", header);
 
 	struct net_buf_simple nbuf;
@@ -274,43 +1018,61 @@ int app_compose(uint8_t *buf, size_t size, size_t *len)
 
 	if (header & BIT(5)) {
 		net_buf_simple_add_be32(&nbuf, input_a_count);
-		/* Append status byte: bit 3=notify_act, bit 2=notify_deact, bit 1=reserved, bit
-		 * 0=is_active */
-		uint8_t status_a = 0;
-		if (input_data.input_a_notify_act) {
-			status_a |= BIT(3);
-		}
-		if (input_data.input_a_notify_deact) {
-			status_a |= BIT(2);
-		}
-		if (input_data.input_a_is_active) {
-			status_a |= BIT(0);
-		}
-		net_buf_simple_add_u8(&nbuf, status_a);
+		net_buf_simple_add_u8(&nbuf, input_status[0]);
 	}
 
 	if (header & BIT(4)) {
 		net_buf_simple_add_be32(&nbuf, input_b_count);
-		/* Append status byte: bit 3=notify_act, bit 2=notify_deact, bit 1=reserved, bit
-		 * 0=is_active */
-		uint8_t status_b = 0;
-		if (input_data.input_b_notify_act) {
-			status_b |= BIT(3);
-		}
-		if (input_data.input_b_notify_deact) {
-			status_b |= BIT(2);
-		}
-		if (input_data.input_b_is_active) {
-			status_b |= BIT(0);
-		}
-		net_buf_simple_add_u8(&nbuf, status_b);
+		net_buf_simple_add_u8(&nbuf, input_status[1]);
 	}
 
+	if (is_counter_delta) {
+		compose_counters(&nbuf, counters, input_status, counter_mask);
+	}
+
+	compose_alarm(&nbuf);
+	compose_w1_topology(&nbuf);
+	compose_t_probes(&nbuf);
+	compose_mp_probes(&nbuf);
+	m_pending.input_data = input_data;
+	m_pending.is_pulse = compose_pulse(&nbuf, &input_data);
+	m_pending.aggreg_until = compose_aggreg(&nbuf);
+	m_pending.batch_timestamp = compose_batch(&nbuf);
+
 	*len = nbuf.len;
 
 	LOG_HEXDUMP_DBG(buf, *len, "Composed buffer:");
 
+	/* Queued reports do not move the baseline of the deltas */
+	memcpy(m_pending.counters, counters, sizeof(m_pending.counters));
+	m_pending.is_counter_baseline = !is_queued;
+
+	/* Full counter values are repeated until a report carries all of them */
+	if (!g_app_config.report_compress || is_counter_dropped) {
+		m_pending.counter_reports = 0;
+	} else if (is_counter_delta) {
+		m_pending.counter_reports = m_counter_reports + 1;
+	} else {
+		m_pending.counter_reports = 1;
+	}
+
 	boot = false;
 
 	return 0;
 }
+
+void app_compose_commit(void)
+{
+	if (m_pending.is_counter_baseline) {
+		memcpy(m_last_counters, m_pending.counters, sizeof(m_last_counters));
+		m_counter_reports = m_pending.counter_reports;
+	}
+
+	m_aggreg_until = m_pending.aggreg_until;
+	m_batch_timestamp = m_pending.batch_timestamp;
+
+	if (m_pending.is_pulse) {
+		app_input_clear_pulse_stats(&m_pending.input_data);
+		m_pending.is_pulse = false;
+	}
+}
@@ -8,6 +8,7 @@
 #define APP_COMPOSE_H_
 
 /* Standard includes */
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -15,7 +16,12 @@
 extern "C" {
 #endif
 
-int app_compose(uint8_t *buf, size_t size, size_t *len);
+/* Queued reports carry the full counter values instead of deltas to the previous report */
+int app_compose(uint8_t *buf, size_t size, size_t *len, bool is_queued);
+
+/* Advance the counter baseline, history cursors and pulse statistics past the last composed
+ * report, called once the report is sent or queued */
+void app_compose_commit(void);
 
 #ifdef __cplusplus
 }
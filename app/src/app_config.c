@@ -34,7 +34,12 @@ struct app_config g_app_config;
 
 static const struct app_config m_app_config_defaults = {
 	.config_version = APP_CONFIG_VERSION,
+	.interval_sample_min = 30,
+	.interval_sample_delta = 0.5f,
 	.interval_report = 900,
+	.report_delta_temperature = 0.5f,
+	.report_delta_humidity = 5.0f,
+	.report_heartbeat = 3600,
 	.alarm_temperature_lo = 15.0f,
 	.alarm_temperature_hi = 25.0f,
 	.alarm_temperature_hst = 0.5f,
@@ -50,11 +55,31 @@ static const struct app_config m_app_config_defaults = {
 	.alarm_t2_temperature_lo = 15.0f,
 	.alarm_t2_temperature_hi = 25.0f,
 	.alarm_t2_temperature_hst = 0.5f,
+	.alarm_illuminance_lo = 10.0f,
+	.alarm_illuminance_hi = 1000.0f,
+	.alarm_illuminance_hst = 5.0f,
+	.alarm_mp_temperature_lo = 15.0f,
+	.alarm_mp_temperature_hi = 25.0f,
+	.alarm_mp_temperature_hst = 0.5f,
+	.alarm_mp_humidity_lo = 30.0f,
+	.alarm_mp_humidity_hi = 75.0f,
+	.alarm_mp_humidity_hst = 5.0f,
+	.alarm_roc_rate = 1.0f,
+	.alarm_roc_window = 300,
+	.alarm_stuck_samples = 20,
+	.input_debounce = 10,
+	.res_t1_temperature = 12,
+	.res_t2_temperature = 12,
 };
 
 static struct app_config m_app_config = {
 	.config_version = APP_CONFIG_VERSION,
+	.interval_sample_min = 30,
+	.interval_sample_delta = 0.5f,
 	.interval_report = 900,
+	.report_delta_temperature = 0.5f,
+	.report_delta_humidity = 5.0f,
+	.report_heartbeat = 3600,
 	.alarm_temperature_lo = 15.0f,
 	.alarm_temperature_hi = 25.0f,
 	.alarm_temperature_hst = 0.5f,
@@ -70,6 +95,21 @@ static struct app_config m_app_config = {
 	.alarm_t2_temperature_lo = 15.0f,
 	.alarm_t2_temperature_hi = 25.0f,
 	.alarm_t2_temperature_hst = 0.5f,
+	.alarm_illuminance_lo = 10.0f,
+	.alarm_illuminance_hi = 1000.0f,
+	.alarm_illuminance_hst = 5.0f,
+	.alarm_mp_temperature_lo = 15.0f,
+	.alarm_mp_temperature_hi = 25.0f,
+	.alarm_mp_temperature_hst = 0.5f,
+	.alarm_mp_humidity_lo = 30.0f,
+	.alarm_mp_humidity_hi = 75.0f,
+	.alarm_mp_humidity_hst = 5.0f,
+	.alarm_roc_rate = 1.0f,
+	.alarm_roc_window = 300,
+	.alarm_stuck_samples = 20,
+	.input_debounce = 10,
+	.res_t1_temperature = 12,
+	.res_t2_temperature = 12,
 };
 
 static int h_set(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg)
@@ -105,8 +145,26 @@ static int h_set(const char *key, size_t len, settings_read_cb read_cb, void *cb
 	SETTINGS_SET("calibration", &m_app_config.calibration, sizeof(m_app_config.calibration));
 	SETTINGS_SET("interval-sample", &m_app_config.interval_sample,
 		     sizeof(m_app_config.interval_sample));
+	SETTINGS_SET("interval-sample-adaptive", &m_app_config.interval_sample_adaptive,
+		     sizeof(m_app_config.interval_sample_adaptive));
+	SETTINGS_SET("interval-sample-min", &m_app_config.interval_sample_min,
+		     sizeof(m_app_config.interval_sample_min));
+	SETTINGS_SET("interval-sample-delta", &m_app_config.interval_sample_delta,
+		     sizeof(m_app_config.interval_sample_delta));
+	SETTINGS_SET("interval-aggreg", &m_app_config.interval_aggreg,
+		     sizeof(m_app_config.interval_aggreg));
 	SETTINGS_SET("interval-report", &m_app_config.interval_report,
 		     sizeof(m_app_config.interval_report));
+	SETTINGS_SET("report-batch", &m_app_config.report_batch, sizeof(m_app_config.report_batch));
+	SETTINGS_SET("report-compress", &m_app_config.report_compress,
+		     sizeof(m_app_config.report_compress));
+	SETTINGS_SET("report-delta", &m_app_config.report_delta, sizeof(m_app_config.report_delta));
+	SETTINGS_SET("report-delta-temperature", &m_app_config.report_delta_temperature,
+		     sizeof(m_app_config.report_delta_temperature));
+	SETTINGS_SET("report-delta-humidity", &m_app_config.report_delta_humidity,
+		     sizeof(m_app_config.report_delta_humidity));
+	SETTINGS_SET("report-heartbeat", &m_app_config.report_heartbeat,
+		     sizeof(m_app_config.report_heartbeat));
 	SETTINGS_SET("lrw-region", &m_app_config.lrw_region, sizeof(m_app_config.lrw_region));
 	SETTINGS_SET("lrw-network", &m_app_config.lrw_network, sizeof(m_app_config.lrw_network));
 	SETTINGS_SET("lrw-adr", &m_app_config.lrw_adr, sizeof(m_app_config.lrw_adr));
@@ -159,36 +217,101 @@ static int h_set(const char *key, size_t len, settings_read_cb read_cb, void *cb
 		     sizeof(m_app_config.alarm_t2_temperature_hi));
 	SETTINGS_SET("alarm-t2-temperature-hst", &m_app_config.alarm_t2_temperature_hst,
 		     sizeof(m_app_config.alarm_t2_temperature_hst));
+	SETTINGS_SET("alarm-illuminance-enabled", &m_app_config.alarm_illuminance_enabled,
+		     sizeof(m_app_config.alarm_illuminance_enabled));
+	SETTINGS_SET("alarm-illuminance-lo", &m_app_config.alarm_illuminance_lo,
+		     sizeof(m_app_config.alarm_illuminance_lo));
+	SETTINGS_SET("alarm-illuminance-hi", &m_app_config.alarm_illuminance_hi,
+		     sizeof(m_app_config.alarm_illuminance_hi));
+	SETTINGS_SET("alarm-illuminance-hst", &m_app_config.alarm_illuminance_hst,
+		     sizeof(m_app_config.alarm_illuminance_hst));
+	SETTINGS_SET("alarm-mp-temperature-enabled", &m_app_config.alarm_mp_temperature_enabled,
+		     sizeof(m_app_config.alarm_mp_temperature_enabled));
+	SETTINGS_SET("alarm-mp-temperature-lo", &m_app_config.alarm_mp_temperature_lo,
+		     sizeof(m_app_config.alarm_mp_temperature_lo));
+	SETTINGS_SET("alarm-mp-temperature-hi", &m_app_config.alarm_mp_temperature_hi,
+		     sizeof(m_app_config.alarm_mp_temperature_hi));
+	SETTINGS_SET("alarm-mp-temperature-hst", &m_app_config.alarm_mp_temperature_hst,
+		     sizeof(m_app_config.alarm_mp_temperature_hst));
+	SETTINGS_SET("alarm-mp-humidity-enabled", &m_app_config.alarm_mp_humidity_enabled,
+		     sizeof(m_app_config.alarm_mp_humidity_enabled));
+	SETTINGS_SET("alarm-mp-humidity-lo", &m_app_config.alarm_mp_humidity_lo,
+		     sizeof(m_app_config.alarm_mp_humidity_lo));
+	SETTINGS_SET("alarm-mp-humidity-hi", &m_app_config.alarm_mp_humidity_hi,
+		     sizeof(m_app_config.alarm_mp_humidity_hi));
+	SETTINGS_SET("alarm-mp-humidity-hst", &m_app_config.alarm_mp_humidity_hst,
+		     sizeof(m_app_config.alarm_mp_humidity_hst));
+	SETTINGS_SET("alarm-notify", &m_app_config.alarm_notify, sizeof(m_app_config.alarm_notify));
+	SETTINGS_SET("alarm-roc-enabled", &m_app_config.alarm_roc_enabled,
+		     sizeof(m_app_config.alarm_roc_enabled));
+	SETTINGS_SET("alarm-roc-rate", &m_app_config.alarm_roc_rate,
+		     sizeof(m_app_config.alarm_roc_rate));
+	SETTINGS_SET("alarm-roc-window", &m_app_config.alarm_roc_window,
+		     sizeof(m_app_config.alarm_roc_window));
+	SETTINGS_SET("alarm-stuck-enabled", &m_app_config.alarm_stuck_enabled,
+		     sizeof(m_app_config.alarm_stuck_enabled));
+	SETTINGS_SET("alarm-stuck-samples", &m_app_config.alarm_stuck_samples,
+		     sizeof(m_app_config.alarm_stuck_samples));
 	SETTINGS_SET("hall-left-counter", &m_app_config.hall_left_counter,
 		     sizeof(m_app_config.hall_left_counter));
 	SETTINGS_SET("hall-left-notify-act", &m_app_config.hall_left_notify_act,
 		     sizeof(m_app_config.hall_left_notify_act));
 	SETTINGS_SET("hall-left-notify-deact", &m_app_config.hall_left_notify_deact,
 		     sizeof(m_app_config.hall_left_notify_deact));
+	SETTINGS_SET("hall-left-interrupt", &m_app_config.hall_left_interrupt,
+		     sizeof(m_app_config.hall_left_interrupt));
 	SETTINGS_SET("hall-right-counter", &m_app_config.hall_right_counter,
 		     sizeof(m_app_config.hall_right_counter));
 	SETTINGS_SET("hall-right-notify-act", &m_app_config.hall_right_notify_act,
 		     sizeof(m_app_config.hall_right_notify_act));
 	SETTINGS_SET("hall-right-notify-deact", &m_app_config.hall_right_notify_deact,
 		     sizeof(m_app_config.hall_right_notify_deact));
+	SETTINGS_SET("hall-right-interrupt", &m_app_config.hall_right_interrupt,
+		     sizeof(m_app_config.hall_right_interrupt));
 	SETTINGS_SET("input-a-counter", &m_app_config.input_a_counter,
 		     sizeof(m_app_config.input_a_counter));
 	SETTINGS_SET("input-a-notify-act", &m_app_config.input_a_notify_act,
 		     sizeof(m_app_config.input_a_notify_act));
 	SETTINGS_SET("input-a-notify-deact", &m_app_config.input_a_notify_deact,
 		     sizeof(m_app_config.input_a_notify_deact));
+	SETTINGS_SET("input-a-interrupt", &m_app_config.input_a_interrupt,
+		     sizeof(m_app_config.input_a_interrupt));
 	SETTINGS_SET("input-b-counter", &m_app_config.input_b_counter,
 		     sizeof(m_app_config.input_b_counter));
 	SETTINGS_SET("input-b-notify-act", &m_app_config.input_b_notify_act,
 		     sizeof(m_app_config.input_b_notify_act));
 	SETTINGS_SET("input-b-notify-deact", &m_app_config.input_b_notify_deact,
 		     sizeof(m_app_config.input_b_notify_deact));
+	SETTINGS_SET("input-b-interrupt", &m_app_config.input_b_interrupt,
+		     sizeof(m_app_config.input_b_interrupt));
+	SETTINGS_SET("input-debounce", &m_app_config.input_debounce,
+		     sizeof(m_app_config.input_debounce));
 	SETTINGS_SET("corr-temperature", &m_app_config.corr_temperature,
 		     sizeof(m_app_config.corr_temperature));
 	SETTINGS_SET("corr-t1-temperature", &m_app_config.corr_t1_temperature,
 		     sizeof(m_app_config.corr_t1_temperature));
 	SETTINGS_SET("corr-t2-temperature", &m_app_config.corr_t2_temperature,
 		     sizeof(m_app_config.corr_t2_temperature));
+	SETTINGS_SET("res-t1-temperature", &m_app_config.res_t1_temperature,
+		     sizeof(m_app_config.res_t1_temperature));
+	SETTINGS_SET("res-t2-temperature", &m_app_config.res_t2_temperature,
+		     sizeof(m_app_config.res_t2_temperature));
+	SETTINGS_SET("rom-t1", m_app_config.rom_t1, sizeof(m_app_config.rom_t1));
+	SETTINGS_SET("rom-t2", m_app_config.rom_t2, sizeof(m_app_config.rom_t2));
+	SETTINGS_SET("rom-t3", m_app_config.rom_t3, sizeof(m_app_config.rom_t3));
+	SETTINGS_SET("rom-t4", m_app_config.rom_t4, sizeof(m_app_config.rom_t4));
+	SETTINGS_SET("rom-t5", m_app_config.rom_t5, sizeof(m_app_config.rom_t5));
+	SETTINGS_SET("rom-t6", m_app_config.rom_t6, sizeof(m_app_config.rom_t6));
+	SETTINGS_SET("rom-t7", m_app_config.rom_t7, sizeof(m_app_config.rom_t7));
+	SETTINGS_SET("rom-t8", m_app_config.rom_t8, sizeof(m_app_config.rom_t8));
+	SETTINGS_SET("rom-mp1", m_app_config.rom_mp1, sizeof(m_app_config.rom_mp1));
+	SETTINGS_SET("rom-mp2", m_app_config.rom_mp2, sizeof(m_app_config.rom_mp2));
+	SETTINGS_SET("rom-mp3", m_app_config.rom_mp3, sizeof(m_app_config.rom_mp3));
+	SETTINGS_SET("rom-mp4", m_app_config.rom_mp4, sizeof(m_app_config.rom_mp4));
+	SETTINGS_SET("rom-mp5", m_app_config.rom_mp5, sizeof(m_app_config.rom_mp5));
+	SETTINGS_SET("rom-mp6", m_app_config.rom_mp6, sizeof(m_app_config.rom_mp6));
+	SETTINGS_SET("rom-mp7", m_app_config.rom_mp7, sizeof(m_app_config.rom_mp7));
+	SETTINGS_SET("rom-mp8", m_app_config.rom_mp8, sizeof(m_app_config.rom_mp8));
 	SETTINGS_SET("cap-hall-left", &m_app_config.cap_hall_left,
 		     sizeof(m_app_config.cap_hall_left));
 	SETTINGS_SET("cap-hall-right", &m_app_config.cap_hall_right,
@@ -242,8 +365,26 @@ static int h_export(int (*export_func)(const char *name, const void *val, size_t
 	EXPORT_FUNC("calibration", &m_app_config.calibration, sizeof(m_app_config.calibration));
 	EXPORT_FUNC("interval-sample", &m_app_config.interval_sample,
 		    sizeof(m_app_config.interval_sample));
+	EXPORT_FUNC("interval-sample-adaptive", &m_app_config.interval_sample_adaptive,
+		    sizeof(m_app_config.interval_sample_adaptive));
+	EXPORT_FUNC("interval-sample-min", &m_app_config.interval_sample_min,
+		    sizeof(m_app_config.interval_sample_min));
+	EXPORT_FUNC("interval-sample-delta", &m_app_config.interval_sample_delta,
+		    sizeof(m_app_config.interval_sample_delta));
+	EXPORT_FUNC("interval-aggreg", &m_app_config.interval_aggreg,
+		    sizeof(m_app_config.interval_aggreg));
 	EXPORT_FUNC("interval-report", &m_app_config.interval_report,
 		    sizeof(m_app_config.interval_report));
+	EXPORT_FUNC("report-batch", &m_app_config.report_batch, sizeof(m_app_config.report_batch));
+	EXPORT_FUNC("report-compress", &m_app_config.report_compress,
+		    sizeof(m_app_config.report_compress));
+	EXPORT_FUNC("report-delta", &m_app_config.report_delta, sizeof(m_app_config.report_delta));
+	EXPORT_FUNC("report-delta-temperature", &m_app_config.report_delta_temperature,
+		    sizeof(m_app_config.report_delta_temperature));
+	EXPORT_FUNC("report-delta-humidity", &m_app_config.report_delta_humidity,
+		    sizeof(m_app_config.report_delta_humidity));
+	EXPORT_FUNC("report-heartbeat", &m_app_config.report_heartbeat,
+		    sizeof(m_app_config.report_heartbeat));
 	EXPORT_FUNC("lrw-region", &m_app_config.lrw_region, sizeof(m_app_config.lrw_region));
 	EXPORT_FUNC("lrw-network", &m_app_config.lrw_network, sizeof(m_app_config.lrw_network));
 	EXPORT_FUNC("lrw-adr", &m_app_config.lrw_adr, sizeof(m_app_config.lrw_adr));
@@ -296,36 +437,101 @@ static int h_export(int (*export_func)(const char *name, const void *val, size_t
 		    sizeof(m_app_config.alarm_t2_temperature_hi));
 	EXPORT_FUNC("alarm-t2-temperature-hst", &m_app_config.alarm_t2_temperature_hst,
 		    sizeof(m_app_config.alarm_t2_temperature_hst));
+	EXPORT_FUNC("alarm-illuminance-enabled", &m_app_config.alarm_illuminance_enabled,
+		    sizeof(m_app_config.alarm_illuminance_enabled));
+	EXPORT_FUNC("alarm-illuminance-lo", &m_app_config.alarm_illuminance_lo,
+		    sizeof(m_app_config.alarm_illuminance_lo));
+	EXPORT_FUNC("alarm-illuminance-hi", &m_app_config.alarm_illuminance_hi,
+		    sizeof(m_app_config.alarm_illuminance_hi));
+	EXPORT_FUNC("alarm-illuminance-hst", &m_app_config.alarm_illuminance_hst,
+		    sizeof(m_app_config.alarm_illuminance_hst));
+	EXPORT_FUNC("alarm-mp-temperature-enabled", &m_app_config.alarm_mp_temperature_enabled,
+		    sizeof(m_app_config.alarm_mp_temperature_enabled));
+	EXPORT_FUNC("alarm-mp-temperature-lo", &m_app_config.alarm_mp_temperature_lo,
+		    sizeof(m_app_config.alarm_mp_temperature_lo));
+	EXPORT_FUNC("alarm-mp-temperature-hi", &m_app_config.alarm_mp_temperature_hi,
+		    sizeof(m_app_config.alarm_mp_temperature_hi));
+	EXPORT_FUNC("alarm-mp-temperature-hst", &m_app_config.alarm_mp_temperature_hst,
+		    sizeof(m_app_config.alarm_mp_temperature_hst));
+	EXPORT_FUNC("alarm-mp-humidity-enabled", &m_app_config.alarm_mp_humidity_enabled,
+		    sizeof(m_app_config.alarm_mp_humidity_enabled));
+	EXPORT_FUNC("alarm-mp-humidity-lo", &m_app_config.alarm_mp_humidity_lo,
+		    sizeof(m_app_config.alarm_mp_humidity_lo));
+	EXPORT_FUNC("alarm-mp-humidity-hi", &m_app_config.alarm_mp_humidity_hi,
+		    sizeof(m_app_config.alarm_mp_humidity_hi));
+	EXPORT_FUNC("alarm-mp-humidity-hst", &m_app_config.alarm_mp_humidity_hst,
+		    sizeof(m_app_config.alarm_mp_humidity_hst));
+	EXPORT_FUNC("alarm-notify", &m_app_config.alarm_notify, sizeof(m_app_config.alarm_notify));
+	EXPORT_FUNC("alarm-roc-enabled", &m_app_config.alarm_roc_enabled,
+		    sizeof(m_app_config.alarm_roc_enabled));
+	EXPORT_FUNC("alarm-roc-rate", &m_app_config.alarm_roc_rate,
+		    sizeof(m_app_config.alarm_roc_rate));
+	EXPORT_FUNC("alarm-roc-window", &m_app_config.alarm_roc_window,
+		    sizeof(m_app_config.alarm_roc_window));
+	EXPORT_FUNC("alarm-stuck-enabled", &m_app_config.alarm_stuck_enabled,
+		    sizeof(m_app_config.alarm_stuck_enabled));
+	EXPORT_FUNC("alarm-stuck-samples", &m_app_config.alarm_stuck_samples,
+		    sizeof(m_app_config.alarm_stuck_samples));
 	EXPORT_FUNC("hall-left-counter", &m_app_config.hall_left_counter,
 		    sizeof(m_app_config.hall_left_counter));
 	EXPORT_FUNC("hall-left-notify-act", &m_app_config.hall_left_notify_act,
 		    sizeof(m_app_config.hall_left_notify_act));
 	EXPORT_FUNC("hall-left-notify-deact", &m_app_config.hall_left_notify_deact,
 		    sizeof(m_app_config.hall_left_notify_deact));
+	EXPORT_FUNC("hall-left-interrupt", &m_app_config.hall_left_interrupt,
+		    sizeof(m_app_config.hall_left_interrupt));
 	EXPORT_FUNC("hall-right-counter", &m_app_config.hall_right_counter,
 		    sizeof(m_app_config.hall_right_counter));
 	EXPORT_FUNC("hall-right-notify-act", &m_app_config.hall_right_notify_act,
 		    sizeof(m_app_config.hall_right_notify_act));
 	EXPORT_FUNC("hall-right-notify-deact", &m_app_config.hall_right_notify_deact,
 		    sizeof(m_app_config.hall_right_notify_deact));
+	EXPORT_FUNC("hall-right-interrupt", &m_app_config.hall_right_interrupt,
+		    sizeof(m_app_config.hall_right_interrupt));
 	EXPORT_FUNC("input-a-counter", &m_app_config.input_a_counter,
 		    sizeof(m_app_config.input_a_counter));
 	EXPORT_FUNC("input-a-notify-act", &m_app_config.input_a_notify_act,
 		    sizeof(m_app_config.input_a_notify_act));
 	EXPORT_FUNC("input-a-notify-deact", &m_app_config.input_a_notify_deact,
 		    sizeof(m_app_config.input_a_notify_deact));
+	EXPORT_FUNC("input-a-interrupt", &m_app_config.input_a_interrupt,
+		    sizeof(m_app_config.input_a_interrupt));
 	EXPORT_FUNC("input-b-counter", &m_app_config.input_b_counter,
 		    sizeof(m_app_config.input_b_counter));
 	EXPORT_FUNC("input-b-notify-act", &m_app_config.input_b_notify_act,
 		    sizeof(m_app_config.input_b_notify_act));
 	EXPORT_FUNC("input-b-notify-deact", &m_app_config.input_b_notify_deact,
 		    sizeof(m_app_config.input_b_notify_deact));
+	EXPORT_FUNC("input-b-interrupt", &m_app_config.input_b_interrupt,
+		    sizeof(m_app_config.input_b_interrupt));
+	EXPORT_FUNC("input-debounce", &m_app_config.input_debounce,
+		    sizeof(m_app_config.input_debounce));
 	EXPORT_FUNC("corr-temperature", &m_app_config.corr_temperature,
 		    sizeof(m_app_config.corr_temperature));
 	EXPORT_FUNC("corr-t1-temperature", &m_app_config.corr_t1_temperature,
 		    sizeof(m_app_config.corr_t1_temperature));
 	EXPORT_FUNC("corr-t2-temperature", &m_app_config.corr_t2_temperature,
 		    sizeof(m_app_config.corr_t2_temperature));
+	EXPORT_FUNC("res-t1-temperature", &m_app_config.res_t1_temperature,
+		    sizeof(m_app_config.res_t1_temperature));
+	EXPORT_FUNC("res-t2-temperature", &m_app_config.res_t2_temperature,
+		    sizeof(m_app_config.res_t2_temperature));
+	EXPORT_FUNC("rom-t1", m_app_config.rom_t1, sizeof(m_app_config.rom_t1));
+	EXPORT_FUNC("rom-t2", m_app_config.rom_t2, sizeof(m_app_config.rom_t2));
+	EXPORT_FUNC("rom-t3", m_app_config.rom_t3, sizeof(m_app_config.rom_t3));
+	EXPORT_FUNC("rom-t4", m_app_config.rom_t4, sizeof(m_app_config.rom_t4));
+	EXPORT_FUNC("rom-t5", m_app_config.rom_t5, sizeof(m_app_config.rom_t5));
+	EXPORT_FUNC("rom-t6", m_app_config.rom_t6, sizeof(m_app_config.rom_t6));
+	EXPORT_FUNC("rom-t7", m_app_config.rom_t7, sizeof(m_app_config.rom_t7));
+	EXPORT_FUNC("rom-t8", m_app_config.rom_t8, sizeof(m_app_config.rom_t8));
+	EXPORT_FUNC("rom-mp1", m_app_config.rom_mp1, sizeof(m_app_config.rom_mp1));
+	EXPORT_FUNC("rom-mp2", m_app_config.rom_mp2, sizeof(m_app_config.rom_mp2));
+	EXPORT_FUNC("rom-mp3", m_app_config.rom_mp3, sizeof(m_app_config.rom_mp3));
+	EXPORT_FUNC("rom-mp4", m_app_config.rom_mp4, sizeof(m_app_config.rom_mp4));
+	EXPORT_FUNC("rom-mp5", m_app_config.rom_mp5, sizeof(m_app_config.rom_mp5));
+	EXPORT_FUNC("rom-mp6", m_app_config.rom_mp6, sizeof(m_app_config.rom_mp6));
+	EXPORT_FUNC("rom-mp7", m_app_config.rom_mp7, sizeof(m_app_config.rom_mp7));
+	EXPORT_FUNC("rom-mp8", m_app_config.rom_mp8, sizeof(m_app_config.rom_mp8));
 	EXPORT_FUNC("cap-hall-left", &m_app_config.cap_hall_left,
 		    sizeof(m_app_config.cap_hall_left));
 	EXPORT_FUNC("cap-hall-right", &m_app_config.cap_hall_right,
@@ -486,11 +692,69 @@ static void print_interval_sample(const struct shell *shell)
 	shell_print(shell, SETTINGS_PFX " interval-sample %d", m_app_config.interval_sample);
 }
 
+static void print_interval_sample_adaptive(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " interval-sample-adaptive %s",
+		    m_app_config.interval_sample_adaptive ? "true" : "false");
+}
+
+static void print_interval_sample_min(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " interval-sample-min %d",
+		    m_app_config.interval_sample_min);
+}
+
+static void print_interval_sample_delta(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " interval-sample-delta %.2f",
+		    (double)m_app_config.interval_sample_delta);
+}
+
+static void print_interval_aggreg(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " interval-aggreg %d", m_app_config.interval_aggreg);
+}
+
 static void print_interval_report(const struct shell *shell)
 {
 	shell_print(shell, SETTINGS_PFX " interval-report %d", m_app_config.interval_report);
 }
 
+static void print_report_batch(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " report-batch %s",
+		    m_app_config.report_batch ? "true" : "false");
+}
+
+static void print_report_compress(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " report-compress %s",
+		    m_app_config.report_compress ? "true" : "false");
+}
+
+static void print_report_delta(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " report-delta %s",
+		    m_app_config.report_delta ? "true" : "false");
+}
+
+static void print_report_delta_temperature(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " report-delta-temperature %.2f",
+		    (double)m_app_config.report_delta_temperature);
+}
+
+static void print_report_delta_humidity(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " report-delta-humidity %.2f",
+		    (double)m_app_config.report_delta_humidity);
+}
+
+static void print_report_heartbeat(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " report-heartbeat %d", m_app_config.report_heartbeat);
+}
+
 static void print_lrw_region(const struct shell *shell)
 {
 	const char *str;
@@ -768,6 +1032,113 @@ static void print_alarm_t2_temperature_hst(const struct shell *shell)
 		    (double)m_app_config.alarm_t2_temperature_hst);
 }
 
+static void print_alarm_illuminance_enabled(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " alarm-illuminance-enabled %s",
+		    m_app_config.alarm_illuminance_enabled ? "true" : "false");
+}
+
+static void print_alarm_illuminance_lo(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " alarm-illuminance-lo %.2f",
+		    (double)m_app_config.alarm_illuminance_lo);
+}
+
+static void print_alarm_illuminance_hi(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " alarm-illuminance-hi %.2f",
+		    (double)m_app_config.alarm_illuminance_hi);
+}
+
+static void print_alarm_illuminance_hst(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " alarm-illuminance-hst %.2f",
+		    (double)m_app_config.alarm_illuminance_hst);
+}
+
+static void print_alarm_mp_temperature_enabled(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " alarm-mp-temperature-enabled %s",
+		    m_app_config.alarm_mp_temperature_enabled ? "true" : "false");
+}
+
+static void print_alarm_mp_temperature_lo(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " alarm-mp-temperature-lo %.2f",
+		    (double)m_app_config.alarm_mp_temperature_lo);
+}
+
+static void print_alarm_mp_temperature_hi(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " alarm-mp-temperature-hi %.2f",
+		    (double)m_app_config.alarm_mp_temperature_hi);
+}
+
+static void print_alarm_mp_temperature_hst(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " alarm-mp-temperature-hst %.2f",
+		    (double)m_app_config.alarm_mp_temperature_hst);
+}
+
+static void print_alarm_mp_humidity_enabled(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " alarm-mp-humidity-enabled %s",
+		    m_app_config.alarm_mp_humidity_enabled ? "true" : "false");
+}
+
+static void print_alarm_mp_humidity_lo(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " alarm-mp-humidity-lo %.2f",
+		    (double)m_app_config.alarm_mp_humidity_lo);
+}
+
+static void print_alarm_mp_humidity_hi(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " alarm-mp-humidity-hi %.2f",
+		    (double)m_app_config.alarm_mp_humidity_hi);
+}
+
+static void print_alarm_mp_humidity_hst(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " alarm-mp-humidity-hst %.2f",
+		    (double)m_app_config.alarm_mp_humidity_hst);
+}
+
+static void print_alarm_notify(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " alarm-notify %s",
+		    m_app_config.alarm_notify ? "true" : "false");
+}
+
+static void print_alarm_roc_enabled(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " alarm-roc-enabled %s",
+		    m_app_config.alarm_roc_enabled ? "true" : "false");
+}
+
+static void print_alarm_roc_rate(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " alarm-roc-rate %.2f",
+		    (double)m_app_config.alarm_roc_rate);
+}
+
+static void print_alarm_roc_window(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " alarm-roc-window %d", m_app_config.alarm_roc_window);
+}
+
+static void print_alarm_stuck_enabled(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " alarm-stuck-enabled %s",
+		    m_app_config.alarm_stuck_enabled ? "true" : "false");
+}
+
+static void print_alarm_stuck_samples(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " alarm-stuck-samples %d",
+		    m_app_config.alarm_stuck_samples);
+}
+
 static void print_hall_left_counter(const struct shell *shell)
 {
 	shell_print(shell, SETTINGS_PFX " hall-left-counter %s",
@@ -786,6 +1157,12 @@ static void print_hall_left_notify_deact(const struct shell *shell)
 		    m_app_config.hall_left_notify_deact ? "true" : "false");
 }
 
+static void print_hall_left_interrupt(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " hall-left-interrupt %s",
+		    m_app_config.hall_left_interrupt ? "true" : "false");
+}
+
 static void print_hall_right_counter(const struct shell *shell)
 {
 	shell_print(shell, SETTINGS_PFX " hall-right-counter %s",
@@ -804,6 +1181,12 @@ static void print_hall_right_notify_deact(const struct shell *shell)
 		    m_app_config.hall_right_notify_deact ? "true" : "false");
 }
 
+static void print_hall_right_interrupt(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " hall-right-interrupt %s",
+		    m_app_config.hall_right_interrupt ? "true" : "false");
+}
+
 static void print_input_a_counter(const struct shell *shell)
 {
 	shell_print(shell, SETTINGS_PFX " input-a-counter %s",
@@ -822,6 +1205,12 @@ static void print_input_a_notify_deact(const struct shell *shell)
 		    m_app_config.input_a_notify_deact ? "true" : "false");
 }
 
+static void print_input_a_interrupt(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " input-a-interrupt %s",
+		    m_app_config.input_a_interrupt ? "true" : "false");
+}
+
 static void print_input_b_counter(const struct shell *shell)
 {
 	shell_print(shell, SETTINGS_PFX " input-b-counter %s",
@@ -840,6 +1229,17 @@ static void print_input_b_notify_deact(const struct shell *shell)
 		    m_app_config.input_b_notify_deact ? "true" : "false");
 }
 
+static void print_input_b_interrupt(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " input-b-interrupt %s",
+		    m_app_config.input_b_interrupt ? "true" : "false");
+}
+
+static void print_input_debounce(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " input-debounce %d", m_app_config.input_debounce);
+}
+
 static void print_corr_temperature(const struct shell *shell)
 {
 	shell_print(shell, SETTINGS_PFX " corr-temperature %.2f",
@@ -858,6 +1258,224 @@ static void print_corr_t2_temperature(const struct shell *shell)
 		    (double)m_app_config.corr_t2_temperature);
 }
 
+static void print_res_t1_temperature(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " res-t1-temperature %d", m_app_config.res_t1_temperature);
+}
+
+static void print_res_t2_temperature(const struct shell *shell)
+{
+	shell_print(shell, SETTINGS_PFX " res-t2-temperature %d", m_app_config.res_t2_temperature);
+}
+
+static void print_rom_t1(const struct shell *shell)
+{
+	char buf[2 * sizeof(m_app_config.rom_t1) + 1];
+
+	int ret = bin2hex(m_app_config.rom_t1, sizeof(m_app_config.rom_t1), buf, sizeof(buf));
+	if (!ret) {
+		LOG_ERR("Call `bin2hex` failed: %d", ret);
+		return;
+	}
+
+	shell_print(shell, SETTINGS_PFX " rom-t1 %s", buf);
+}
+
+static void print_rom_t2(const struct shell *shell)
+{
+	char buf[2 * sizeof(m_app_config.rom_t2) + 1];
+
+	int ret = bin2hex(m_app_config.rom_t2, sizeof(m_app_config.rom_t2), buf, sizeof(buf));
+	if (!ret) {
+		LOG_ERR("Call `bin2hex` failed: %d", ret);
+		return;
+	}
+
+	shell_print(shell, SETTINGS_PFX " rom-t2 %s", buf);
+}
+
+static void print_rom_t3(const struct shell *shell)
+{
+	char buf[2 * sizeof(m_app_config.rom_t3) + 1];
+
+	int ret = bin2hex(m_app_config.rom_t3, sizeof(m_app_config.rom_t3), buf, sizeof(buf));
+	if (!ret) {
+		LOG_ERR("Call `bin2hex` failed: %d", ret);
+		return;
+	}
+
+	shell_print(shell, SETTINGS_PFX " rom-t3 %s", buf);
+}
+
+static void print_rom_t4(const struct shell *shell)
+{
+	char buf[2 * sizeof(m_app_config.rom_t4) + 1];
+
+	int ret = bin2hex(m_app_config.rom_t4, sizeof(m_app_config.rom_t4), buf, sizeof(buf));
+	if (!ret) {
+		LOG_ERR("Call `bin2hex` failed: %d", ret);
+		return;
+	}
+
+	shell_print(shell, SETTINGS_PFX " rom-t4 %s", buf);
+}
+
+static void print_rom_t5(const struct shell *shell)
+{
+	char buf[2 * sizeof(m_app_config.rom_t5) + 1];
+
+	int ret = bin2hex(m_app_config.rom_t5, sizeof(m_app_config.rom_t5), buf, sizeof(buf));
+	if (!ret) {
+		LOG_ERR("Call `bin2hex` failed: %d", ret);
+		return;
+	}
+
+	shell_print(shell, SETTINGS_PFX " rom-t5 %s", buf);
+}
+
+static void print_rom_t6(const struct shell *shell)
+{
+	char buf[2 * sizeof(m_app_config.rom_t6) + 1];
+
+	int ret = bin2hex(m_app_config.rom_t6, sizeof(m_app_config.rom_t6), buf, sizeof(buf));
+	if (!ret) {
+		LOG_ERR("Call `bin2hex` failed: %d", ret);
+		return;
+	}
+
+	shell_print(shell, SETTINGS_PFX " rom-t6 %s", buf);
+}
+
+static void print_rom_t7(const struct shell *shell)
+{
+	char buf[2 * sizeof(m_app_config.rom_t7) + 1];
+
+	int ret = bin2hex(m_app_config.rom_t7, sizeof(m_app_config.rom_t7), buf, sizeof(buf));
+	if (!ret) {
+		LOG_ERR("Call `bin2hex` failed: %d", ret);
+		return;
+	}
+
+	shell_print(shell, SETTINGS_PFX " rom-t7 %s", buf);
+}
+
+static void print_rom_t8(const struct shell *shell)
+{
+	char buf[2 * sizeof(m_app_config.rom_t8) + 1];
+
+	int ret = bin2hex(m_app_config.rom_t8, sizeof(m_app_config.rom_t8), buf, sizeof(buf));
+	if (!ret) {
+		LOG_ERR("Call `bin2hex` failed: %d", ret);
+		return;
+	}
+
+	shell_print(shell, SETTINGS_PFX " rom-t8 %s", buf);
+}
+
+static void print_rom_mp1(const struct shell *shell)
+{
+	char buf[2 * sizeof(m_app_config.rom_mp1) + 1];
+
+	int ret = bin2hex(m_app_config.rom_mp1, sizeof(m_app_config.rom_mp1), buf, sizeof(buf));
+	if (!ret) {
+		LOG_ERR("Call `bin2hex` failed: %d", ret);
+		return;
+	}
+
+	shell_print(shell, SETTINGS_PFX " rom-mp1 %s", buf);
+}
+
+static void print_rom_mp2(const struct shell *shell)
+{
+	char buf[2 * sizeof(m_app_config.rom_mp2) + 1];
+
+	int ret = bin2hex(m_app_config.rom_mp2, sizeof(m_app_config.rom_mp2), buf, sizeof(buf));
+	if (!ret) {
+		LOG_ERR("Call `bin2hex` failed: %d", ret);
+		return;
+	}
+
+	shell_print(shell, SETTINGS_PFX " rom-mp2 %s", buf);
+}
+
+static void print_rom_mp3(const struct shell *shell)
+{
+	char buf[2 * sizeof(m_app_config.rom_mp3) + 1];
+
+	int ret = bin2hex(m_app_config.rom_mp3, sizeof(m_app_config.rom_mp3), buf, sizeof(buf));
+	if (!ret) {
+		LOG_ERR("Call `bin2hex` failed: %d", ret);
+		return;
+	}
+
+	shell_print(shell, SETTINGS_PFX " rom-mp3 %s", buf);
+}
+
+static void print_rom_mp4(const struct shell *shell)
+{
+	char buf[2 * sizeof(m_app_config.rom_mp4) + 1];
+
+	int ret = bin2hex(m_app_config.rom_mp4, sizeof(m_app_config.rom_mp4), buf, sizeof(buf));
+	if (!ret) {
+		LOG_ERR("Call `bin2hex` failed: %d", ret);
+		return;
+	}
+
+	shell_print(shell, SETTINGS_PFX " rom-mp4 %s", buf);
+}
+
+static void print_rom_mp5(const struct shell *shell)
+{
+	char buf[2 * sizeof(m_app_config.rom_mp5) + 1];
+
+	int ret = bin2hex(m_app_config.rom_mp5, sizeof(m_app_config.rom_mp5), buf, sizeof(buf));
+	if (!ret) {
+		LOG_ERR("Call `bin2hex` failed: %d", ret);
+		return;
+	}
+
+	shell_print(shell, SETTINGS_PFX " rom-mp5 %s", buf);
+}
+
+static void print_rom_mp6(const struct shell *shell)
+{
+	char buf[2 * sizeof(m_app_config.rom_mp6) + 1];
+
+	int ret = bin2hex(m_app_config.rom_mp6, sizeof(m_app_config.rom_mp6), buf, sizeof(buf));
+	if (!ret) {
+		LOG_ERR("Call `bin2hex` failed: %d", ret);
+		return;
+	}
+
+	shell_print(shell, SETTINGS_PFX " rom-mp6 %s", buf);
+}
+
+static void print_rom_mp7(const struct shell *shell)
+{
+	char buf[2 * sizeof(m_app_config.rom_mp7) + 1];
+
+	int ret = bin2hex(m_app_config.rom_mp7, sizeof(m_app_config.rom_mp7), buf, sizeof(buf));
+	if (!ret) {
+		LOG_ERR("Call `bin2hex` failed: %d", ret);
+		return;
+	}
+
+	shell_print(shell, SETTINGS_PFX " rom-mp7 %s", buf);
+}
+
+static void print_rom_mp8(const struct shell *shell)
+{
+	char buf[2 * sizeof(m_app_config.rom_mp8) + 1];
+
+	int ret = bin2hex(m_app_config.rom_mp8, sizeof(m_app_config.rom_mp8), buf, sizeof(buf));
+	if (!ret) {
+		LOG_ERR("Call `bin2hex` failed: %d", ret);
+		return;
+	}
+
+	shell_print(shell, SETTINGS_PFX " rom-mp8 %s", buf);
+}
+
 static void print_cap_hall_left(const struct shell *shell)
 {
 	shell_print(shell, SETTINGS_PFX " cap-hall-left %s",
@@ -919,7 +1537,17 @@ static int cmd_show(const struct shell *shell, size_t argc, char **argv)
 	print_nonce_counter(shell);
 	print_calibration(shell);
 	print_interval_sample(shell);
+	print_interval_sample_adaptive(shell);
+	print_interval_sample_min(shell);
+	print_interval_sample_delta(shell);
+	print_interval_aggreg(shell);
 	print_interval_report(shell);
+	print_report_batch(shell);
+	print_report_compress(shell);
+	print_report_delta(shell);
+	print_report_delta_temperature(shell);
+	print_report_delta_humidity(shell);
+	print_report_heartbeat(shell);
 	print_lrw_region(shell);
 	print_lrw_network(shell);
 	print_lrw_adr(shell);
@@ -951,21 +1579,62 @@ static int cmd_show(const struct shell *shell, size_t argc, char **argv)
 	print_alarm_t2_temperature_lo(shell);
 	print_alarm_t2_temperature_hi(shell);
 	print_alarm_t2_temperature_hst(shell);
+	print_alarm_illuminance_enabled(shell);
+	print_alarm_illuminance_lo(shell);
+	print_alarm_illuminance_hi(shell);
+	print_alarm_illuminance_hst(shell);
+	print_alarm_mp_temperature_enabled(shell);
+	print_alarm_mp_temperature_lo(shell);
+	print_alarm_mp_temperature_hi(shell);
+	print_alarm_mp_temperature_hst(shell);
+	print_alarm_mp_humidity_enabled(shell);
+	print_alarm_mp_humidity_lo(shell);
+	print_alarm_mp_humidity_hi(shell);
+	print_alarm_mp_humidity_hst(shell);
+	print_alarm_notify(shell);
+	print_alarm_roc_enabled(shell);
+	print_alarm_roc_rate(shell);
+	print_alarm_roc_window(shell);
+	print_alarm_stuck_enabled(shell);
+	print_alarm_stuck_samples(shell);
 	print_hall_left_counter(shell);
 	print_hall_left_notify_act(shell);
 	print_hall_left_notify_deact(shell);
+	print_hall_left_interrupt(shell);
 	print_hall_right_counter(shell);
 	print_hall_right_notify_act(shell);
 	print_hall_right_notify_deact(shell);
+	print_hall_right_interrupt(shell);
 	print_input_a_counter(shell);
 	print_input_a_notify_act(shell);
 	print_input_a_notify_deact(shell);
+	print_input_a_interrupt(shell);
 	print_input_b_counter(shell);
 	print_input_b_notify_act(shell);
 	print_input_b_notify_deact(shell);
+	print_input_b_interrupt(shell);
+	print_input_debounce(shell);
 	print_corr_temperature(shell);
 	print_corr_t1_temperature(shell);
 	print_corr_t2_temperature(shell);
+	print_res_t1_temperature(shell);
+	print_res_t2_temperature(shell);
+	print_rom_t1(shell);
+	print_rom_t2(shell);
+	print_rom_t3(shell);
+	print_rom_t4(shell);
+	print_rom_t5(shell);
+	print_rom_t6(shell);
+	print_rom_t7(shell);
+	print_rom_t8(shell);
+	print_rom_mp1(shell);
+	print_rom_mp2(shell);
+	print_rom_mp3(shell);
+	print_rom_mp4(shell);
+	print_rom_mp5(shell);
+	print_rom_mp6(shell);
+	print_rom_mp7(shell);
+	print_rom_mp8(shell);
 	print_cap_hall_left(shell);
 	print_cap_hall_right(shell);
 	print_cap_input_a(shell);
@@ -1117,17 +1786,98 @@ static int cmd_interval_sample(const struct shell *shell, size_t argc, char **ar
 	return 0;
 }
 
-static int cmd_interval_report(const struct shell *shell, size_t argc, char **argv)
+static int cmd_interval_sample_adaptive(const struct shell *shell, size_t argc, char **argv)
 {
-	return cmd_int(shell, argc, argv, &m_app_config.interval_report, 60, 86400,
-		       print_interval_report);
+	return cmd_bool(shell, argc, argv, &m_app_config.interval_sample_adaptive,
+			print_interval_sample_adaptive);
 }
 
-static int cmd_lrw_region(const struct shell *shell, size_t argc, char **argv)
+static int cmd_interval_sample_min(const struct shell *shell, size_t argc, char **argv)
 {
-	if (argc == 1) {
-		print_lrw_region(shell);
-		return 0;
+	return cmd_int(shell, argc, argv, &m_app_config.interval_sample_min, 5, 3600,
+		       print_interval_sample_min);
+}
+
+static int cmd_interval_sample_delta(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_float(shell, argc, argv, &m_app_config.interval_sample_delta, 0.1f, 10.0f,
+			 print_interval_sample_delta);
+}
+
+static int cmd_interval_aggreg(const struct shell *shell, size_t argc, char **argv)
+{
+	if (argc == 1) {
+		print_interval_aggreg(shell);
+		return 0;
+	}
+
+	if (argc != 2) {
+		shell_error(shell, "%s", m_msg_invalid_args);
+		return -EINVAL;
+	}
+
+	char *endptr;
+	int a = strtol(argv[1], &endptr, 10);
+
+	if (*endptr != '\0') {
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return -EINVAL;
+	}
+
+	if (a != 0 && (a < 60 || a > 86400)) {
+		shell_error(shell, "%s", m_msg_invalid_range);
+		return -EINVAL;
+	}
+
+	m_app_config.interval_aggreg = a;
+
+	return 0;
+}
+
+static int cmd_interval_report(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_int(shell, argc, argv, &m_app_config.interval_report, 60, 86400,
+		       print_interval_report);
+}
+
+static int cmd_report_batch(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.report_batch, print_report_batch);
+}
+
+static int cmd_report_compress(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.report_compress, print_report_compress);
+}
+
+static int cmd_report_delta(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.report_delta, print_report_delta);
+}
+
+static int cmd_report_delta_temperature(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_float(shell, argc, argv, &m_app_config.report_delta_temperature, 0.1f, 10.0f,
+			 print_report_delta_temperature);
+}
+
+static int cmd_report_delta_humidity(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_float(shell, argc, argv, &m_app_config.report_delta_humidity, 1.0f, 50.0f,
+			 print_report_delta_humidity);
+}
+
+static int cmd_report_heartbeat(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_int(shell, argc, argv, &m_app_config.report_heartbeat, 600, 86400,
+		       print_report_heartbeat);
+}
+
+static int cmd_lrw_region(const struct shell *shell, size_t argc, char **argv)
+{
+	if (argc == 1) {
+		print_lrw_region(shell);
+		return 0;
 	}
 
 	if (argc != 2) {
@@ -1532,6 +2282,113 @@ static int cmd_alarm_t2_temperature_hst(const struct shell *shell, size_t argc,
 			 print_alarm_t2_temperature_hst);
 }
 
+static int cmd_alarm_illuminance_enabled(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.alarm_illuminance_enabled,
+			print_alarm_illuminance_enabled);
+}
+
+static int cmd_alarm_illuminance_lo(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_float(shell, argc, argv, &m_app_config.alarm_illuminance_lo, 0.0f, 80000.0f,
+			 print_alarm_illuminance_lo);
+}
+
+static int cmd_alarm_illuminance_hi(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_float(shell, argc, argv, &m_app_config.alarm_illuminance_hi, 0.0f, 80000.0f,
+			 print_alarm_illuminance_hi);
+}
+
+static int cmd_alarm_illuminance_hst(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_float(shell, argc, argv, &m_app_config.alarm_illuminance_hst, 0.0f, 1000.0f,
+			 print_alarm_illuminance_hst);
+}
+
+static int cmd_alarm_mp_temperature_enabled(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.alarm_mp_temperature_enabled,
+			print_alarm_mp_temperature_enabled);
+}
+
+static int cmd_alarm_mp_temperature_lo(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_float(shell, argc, argv, &m_app_config.alarm_mp_temperature_lo, -40.0f, 125.0f,
+			 print_alarm_mp_temperature_lo);
+}
+
+static int cmd_alarm_mp_temperature_hi(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_float(shell, argc, argv, &m_app_config.alarm_mp_temperature_hi, -40.0f, 125.0f,
+			 print_alarm_mp_temperature_hi);
+}
+
+static int cmd_alarm_mp_temperature_hst(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_float(shell, argc, argv, &m_app_config.alarm_mp_temperature_hst, 0.0f, 5.0f,
+			 print_alarm_mp_temperature_hst);
+}
+
+static int cmd_alarm_mp_humidity_enabled(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.alarm_mp_humidity_enabled,
+			print_alarm_mp_humidity_enabled);
+}
+
+static int cmd_alarm_mp_humidity_lo(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_float(shell, argc, argv, &m_app_config.alarm_mp_humidity_lo, 0.0f, 100.0f,
+			 print_alarm_mp_humidity_lo);
+}
+
+static int cmd_alarm_mp_humidity_hi(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_float(shell, argc, argv, &m_app_config.alarm_mp_humidity_hi, 0.0f, 100.0f,
+			 print_alarm_mp_humidity_hi);
+}
+
+static int cmd_alarm_mp_humidity_hst(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_float(shell, argc, argv, &m_app_config.alarm_mp_humidity_hst, 0.0f, 20.0f,
+			 print_alarm_mp_humidity_hst);
+}
+
+static int cmd_alarm_notify(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.alarm_notify, print_alarm_notify);
+}
+
+static int cmd_alarm_roc_enabled(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.alarm_roc_enabled,
+			print_alarm_roc_enabled);
+}
+
+static int cmd_alarm_roc_rate(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_float(shell, argc, argv, &m_app_config.alarm_roc_rate, 0.1f, 10.0f,
+			 print_alarm_roc_rate);
+}
+
+static int cmd_alarm_roc_window(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_int(shell, argc, argv, &m_app_config.alarm_roc_window, 60, 3600,
+		       print_alarm_roc_window);
+}
+
+static int cmd_alarm_stuck_enabled(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.alarm_stuck_enabled,
+			print_alarm_stuck_enabled);
+}
+
+static int cmd_alarm_stuck_samples(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_int(shell, argc, argv, &m_app_config.alarm_stuck_samples, 3, 1000,
+		       print_alarm_stuck_samples);
+}
+
 static int cmd_hall_left_counter(const struct shell *shell, size_t argc, char **argv)
 {
 	return cmd_bool(shell, argc, argv, &m_app_config.hall_left_counter,
@@ -1550,6 +2407,12 @@ static int cmd_hall_left_notify_deact(const struct shell *shell, size_t argc, ch
 			print_hall_left_notify_deact);
 }
 
+static int cmd_hall_left_interrupt(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.hall_left_interrupt,
+			print_hall_left_interrupt);
+}
+
 static int cmd_hall_right_counter(const struct shell *shell, size_t argc, char **argv)
 {
 	return cmd_bool(shell, argc, argv, &m_app_config.hall_right_counter,
@@ -1568,6 +2431,12 @@ static int cmd_hall_right_notify_deact(const struct shell *shell, size_t argc, c
 			print_hall_right_notify_deact);
 }
 
+static int cmd_hall_right_interrupt(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.hall_right_interrupt,
+			print_hall_right_interrupt);
+}
+
 static int cmd_input_a_counter(const struct shell *shell, size_t argc, char **argv)
 {
 	return cmd_bool(shell, argc, argv, &m_app_config.input_a_counter, print_input_a_counter);
@@ -1585,6 +2454,12 @@ static int cmd_input_a_notify_deact(const struct shell *shell, size_t argc, char
 			print_input_a_notify_deact);
 }
 
+static int cmd_input_a_interrupt(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.input_a_interrupt,
+			print_input_a_interrupt);
+}
+
 static int cmd_input_b_counter(const struct shell *shell, size_t argc, char **argv)
 {
 	return cmd_bool(shell, argc, argv, &m_app_config.input_b_counter, print_input_b_counter);
@@ -1602,6 +2477,18 @@ static int cmd_input_b_notify_deact(const struct shell *shell, size_t argc, char
 			print_input_b_notify_deact);
 }
 
+static int cmd_input_b_interrupt(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.input_b_interrupt,
+			print_input_b_interrupt);
+}
+
+static int cmd_input_debounce(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_int(shell, argc, argv, &m_app_config.input_debounce, 0, 1000,
+		       print_input_debounce);
+}
+
 static int cmd_corr_temperature(const struct shell *shell, size_t argc, char **argv)
 {
 	return cmd_float(shell, argc, argv, &m_app_config.corr_temperature, -5.0f, 5.0f,
@@ -1620,104 +2507,620 @@ static int cmd_corr_t2_temperature(const struct shell *shell, size_t argc, char
 			 print_corr_t2_temperature);
 }
 
-static int cmd_cap_hall_left(const struct shell *shell, size_t argc, char **argv)
+static int cmd_res_t1_temperature(const struct shell *shell, size_t argc, char **argv)
 {
-	return cmd_bool(shell, argc, argv, &m_app_config.cap_hall_left, print_cap_hall_left);
+	return cmd_int(shell, argc, argv, &m_app_config.res_t1_temperature, 9, 12,
+		       print_res_t1_temperature);
 }
 
-static int cmd_cap_hall_right(const struct shell *shell, size_t argc, char **argv)
+static int cmd_res_t2_temperature(const struct shell *shell, size_t argc, char **argv)
 {
-	return cmd_bool(shell, argc, argv, &m_app_config.cap_hall_right, print_cap_hall_right);
+	return cmd_int(shell, argc, argv, &m_app_config.res_t2_temperature, 9, 12,
+		       print_res_t2_temperature);
 }
 
-static int cmd_cap_input_a(const struct shell *shell, size_t argc, char **argv)
+static int cmd_rom_t1(const struct shell *shell, size_t argc, char **argv)
 {
-	return cmd_bool(shell, argc, argv, &m_app_config.cap_input_a, print_cap_input_a);
-}
+	int ret;
 
-static int cmd_cap_input_b(const struct shell *shell, size_t argc, char **argv)
-{
-	return cmd_bool(shell, argc, argv, &m_app_config.cap_input_b, print_cap_input_b);
-}
+	if (argc == 1) {
+		print_rom_t1(shell);
+		return 0;
+	}
 
-static int cmd_cap_light_sensor(const struct shell *shell, size_t argc, char **argv)
-{
-	return cmd_bool(shell, argc, argv, &m_app_config.cap_light_sensor, print_cap_light_sensor);
-}
+	if (argc != 2) {
+		shell_error(shell, "%s", m_msg_invalid_args);
+		return -EINVAL;
+	}
 
-static int cmd_cap_barometer(const struct shell *shell, size_t argc, char **argv)
-{
-	return cmd_bool(shell, argc, argv, &m_app_config.cap_barometer, print_cap_barometer);
-}
+	if (strlen(argv[1]) != 2 * sizeof(m_app_config.rom_t1)) {
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return -EINVAL;
+	}
 
-static int cmd_cap_pir_detector(const struct shell *shell, size_t argc, char **argv)
-{
-	return cmd_bool(shell, argc, argv, &m_app_config.cap_pir_detector, print_cap_pir_detector);
-}
+	ret = hex2bin(argv[1], strlen(argv[1]), m_app_config.rom_t1, sizeof(m_app_config.rom_t1));
+	if (!ret) {
+		LOG_ERR("Call `hex2bin` failed: %d", ret);
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return ret;
+	}
 
-static int cmd_cap_1w_thermometer(const struct shell *shell, size_t argc, char **argv)
-{
-	return cmd_bool(shell, argc, argv, &m_app_config.cap_1w_thermometer,
-			print_cap_1w_thermometer);
+	return 0;
 }
 
-static int cmd_cap_1w_machine_probe(const struct shell *shell, size_t argc, char **argv)
+static int cmd_rom_t2(const struct shell *shell, size_t argc, char **argv)
 {
-	return cmd_bool(shell, argc, argv, &m_app_config.cap_1w_machine_probe,
-			print_cap_1w_machine_probe);
-}
+	int ret;
 
-static int print_help(const struct shell *shell, size_t argc, char **argv)
-{
-	if (argc > 1) {
-		shell_error(shell, "command not found: %s", argv[1]);
-		shell_help(shell);
+	if (argc == 1) {
+		print_rom_t2(shell);
+		return 0;
+	}
+
+	if (argc != 2) {
+		shell_error(shell, "%s", m_msg_invalid_args);
 		return -EINVAL;
 	}
 
-	shell_help(shell);
+	if (strlen(argv[1]) != 2 * sizeof(m_app_config.rom_t2)) {
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return -EINVAL;
+	}
+
+	ret = hex2bin(argv[1], strlen(argv[1]), m_app_config.rom_t2, sizeof(m_app_config.rom_t2));
+	if (!ret) {
+		LOG_ERR("Call `hex2bin` failed: %d", ret);
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return ret;
+	}
 
 	return 0;
 }
 
-/* clang-format off */
-
-SHELL_STATIC_SUBCMD_SET_CREATE(
-	sub_config,
+static int cmd_rom_t3(const struct shell *shell, size_t argc, char **argv)
+{
+	int ret;
 
-	SHELL_CMD_ARG(show, NULL,
-	              "Show all configuration.",
-	              cmd_show, 1, 0),
+	if (argc == 1) {
+		print_rom_t3(shell);
+		return 0;
+	}
 
-	SHELL_CMD_ARG(secret-key, NULL,
-	              "Get/Set device secret key (32 hexadecimal digits).",
-	              cmd_secret_key, 1, 1),
+	if (argc != 2) {
+		shell_error(shell, "%s", m_msg_invalid_args);
+		return -EINVAL;
+	}
 
-	SHELL_CMD_ARG(serial-number, NULL,
-	              "Get/Set device serial number (10 decimal digits).",
-	              cmd_serial_number, 1, 1),
+	if (strlen(argv[1]) != 2 * sizeof(m_app_config.rom_t3)) {
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return -EINVAL;
+	}
 
-	SHELL_CMD_ARG(nonce-counter, NULL,
-	              "Get/Set nonce counter (unsigned integer).",
-	              cmd_nonce_counter, 1, 1),
+	ret = hex2bin(argv[1], strlen(argv[1]), m_app_config.rom_t3, sizeof(m_app_config.rom_t3));
+	if (!ret) {
+		LOG_ERR("Call `hex2bin` failed: %d", ret);
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return ret;
+	}
 
-	SHELL_CMD_ARG(calibration, NULL,
-	              "Get/Set calibration mode (true/false).",
-	              cmd_calibration, 1, 1),
+	return 0;
+}
 
-	SHELL_CMD_ARG(interval-sample, NULL,
-	              "Get/Set sample interval (range 5 to 3600 seconds; 0 = precede report).",
-	              cmd_interval_sample, 1, 1),
+static int cmd_rom_t4(const struct shell *shell, size_t argc, char **argv)
+{
+	int ret;
 
-	SHELL_CMD_ARG(interval-report, NULL,
-	              "Get/Set report interval (range 60 to 86400 seconds).",
-	              cmd_interval_report, 1, 1),
+	if (argc == 1) {
+		print_rom_t4(shell);
+		return 0;
+	}
 
-	SHELL_CMD_ARG(lrw-region, NULL,
-	              "Get/Set LoRaWAN region (eu868/us915/au915).",
-	              cmd_lrw_region, 1, 1),
+	if (argc != 2) {
+		shell_error(shell, "%s", m_msg_invalid_args);
+		return -EINVAL;
+	}
 
-	SHELL_CMD_ARG(lrw-network, NULL,
+	if (strlen(argv[1]) != 2 * sizeof(m_app_config.rom_t4)) {
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return -EINVAL;
+	}
+
+	ret = hex2bin(argv[1], strlen(argv[1]), m_app_config.rom_t4, sizeof(m_app_config.rom_t4));
+	if (!ret) {
+		LOG_ERR("Call `hex2bin` failed: %d", ret);
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return ret;
+	}
+
+	return 0;
+}
+
+static int cmd_rom_t5(const struct shell *shell, size_t argc, char **argv)
+{
+	int ret;
+
+	if (argc == 1) {
+		print_rom_t5(shell);
+		return 0;
+	}
+
+	if (argc != 2) {
+		shell_error(shell, "%s", m_msg_invalid_args);
+		return -EINVAL;
+	}
+
+	if (strlen(argv[1]) != 2 * sizeof(m_app_config.rom_t5)) {
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return -EINVAL;
+	}
+
+	ret = hex2bin(argv[1], strlen(argv[1]), m_app_config.rom_t5, sizeof(m_app_config.rom_t5));
+	if (!ret) {
+		LOG_ERR("Call `hex2bin` failed: %d", ret);
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return ret;
+	}
+
+	return 0;
+}
+
+static int cmd_rom_t6(const struct shell *shell, size_t argc, char **argv)
+{
+	int ret;
+
+	if (argc == 1) {
+		print_rom_t6(shell);
+		return 0;
+	}
+
+	if (argc != 2) {
+		shell_error(shell, "%s", m_msg_invalid_args);
+		return -EINVAL;
+	}
+
+	if (strlen(argv[1]) != 2 * sizeof(m_app_config.rom_t6)) {
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return -EINVAL;
+	}
+
+	ret = hex2bin(argv[1], strlen(argv[1]), m_app_config.rom_t6, sizeof(m_app_config.rom_t6));
+	if (!ret) {
+		LOG_ERR("Call `hex2bin` failed: %d", ret);
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return ret;
+	}
+
+	return 0;
+}
+
+static int cmd_rom_t7(const struct shell *shell, size_t argc, char **argv)
+{
+	int ret;
+
+	if (argc == 1) {
+		print_rom_t7(shell);
+		return 0;
+	}
+
+	if (argc != 2) {
+		shell_error(shell, "%s", m_msg_invalid_args);
+		return -EINVAL;
+	}
+
+	if (strlen(argv[1]) != 2 * sizeof(m_app_config.rom_t7)) {
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return -EINVAL;
+	}
+
+	ret = hex2bin(argv[1], strlen(argv[1]), m_app_config.rom_t7, sizeof(m_app_config.rom_t7));
+	if (!ret) {
+		LOG_ERR("Call `hex2bin` failed: %d", ret);
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return ret;
+	}
+
+	return 0;
+}
+
+static int cmd_rom_t8(const struct shell *shell, size_t argc, char **argv)
+{
+	int ret;
+
+	if (argc == 1) {
+		print_rom_t8(shell);
+		return 0;
+	}
+
+	if (argc != 2) {
+		shell_error(shell, "%s", m_msg_invalid_args);
+		return -EINVAL;
+	}
+
+	if (strlen(argv[1]) != 2 * sizeof(m_app_config.rom_t8)) {
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return -EINVAL;
+	}
+
+	ret = hex2bin(argv[1], strlen(argv[1]), m_app_config.rom_t8, sizeof(m_app_config.rom_t8));
+	if (!ret) {
+		LOG_ERR("Call `hex2bin` failed: %d", ret);
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return ret;
+	}
+
+	return 0;
+}
+
+static int cmd_rom_mp1(const struct shell *shell, size_t argc, char **argv)
+{
+	int ret;
+
+	if (argc == 1) {
+		print_rom_mp1(shell);
+		return 0;
+	}
+
+	if (argc != 2) {
+		shell_error(shell, "%s", m_msg_invalid_args);
+		return -EINVAL;
+	}
+
+	if (strlen(argv[1]) != 2 * sizeof(m_app_config.rom_mp1)) {
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return -EINVAL;
+	}
+
+	ret = hex2bin(argv[1], strlen(argv[1]), m_app_config.rom_mp1, sizeof(m_app_config.rom_mp1));
+	if (!ret) {
+		LOG_ERR("Call `hex2bin` failed: %d", ret);
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return ret;
+	}
+
+	return 0;
+}
+
+static int cmd_rom_mp2(const struct shell *shell, size_t argc, char **argv)
+{
+	int ret;
+
+	if (argc == 1) {
+		print_rom_mp2(shell);
+		return 0;
+	}
+
+	if (argc != 2) {
+		shell_error(shell, "%s", m_msg_invalid_args);
+		return -EINVAL;
+	}
+
+	if (strlen(argv[1]) != 2 * sizeof(m_app_config.rom_mp2)) {
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return -EINVAL;
+	}
+
+	ret = hex2bin(argv[1], strlen(argv[1]), m_app_config.rom_mp2, sizeof(m_app_config.rom_mp2));
+	if (!ret) {
+		LOG_ERR("Call `hex2bin` failed: %d", ret);
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return ret;
+	}
+
+	return 0;
+}
+
+static int cmd_rom_mp3(const struct shell *shell, size_t argc, char **argv)
+{
+	int ret;
+
+	if (argc == 1) {
+		print_rom_mp3(shell);
+		return 0;
+	}
+
+	if (argc != 2) {
+		shell_error(shell, "%s", m_msg_invalid_args);
+		return -EINVAL;
+	}
+
+	if (strlen(argv[1]) != 2 * sizeof(m_app_config.rom_mp3)) {
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return -EINVAL;
+	}
+
+	ret = hex2bin(argv[1], strlen(argv[1]), m_app_config.rom_mp3, sizeof(m_app_config.rom_mp3));
+	if (!ret) {
+		LOG_ERR("Call `hex2bin` failed: %d", ret);
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return ret;
+	}
+
+	return 0;
+}
+
+static int cmd_rom_mp4(const struct shell *shell, size_t argc, char **argv)
+{
+	int ret;
+
+	if (argc == 1) {
+		print_rom_mp4(shell);
+		return 0;
+	}
+
+	if (argc != 2) {
+		shell_error(shell, "%s", m_msg_invalid_args);
+		return -EINVAL;
+	}
+
+	if (strlen(argv[1]) != 2 * sizeof(m_app_config.rom_mp4)) {
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return -EINVAL;
+	}
+
+	ret = hex2bin(argv[1], strlen(argv[1]), m_app_config.rom_mp4, sizeof(m_app_config.rom_mp4));
+	if (!ret) {
+		LOG_ERR("Call `hex2bin` failed: %d", ret);
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return ret;
+	}
+
+	return 0;
+}
+
+static int cmd_rom_mp5(const struct shell *shell, size_t argc, char **argv)
+{
+	int ret;
+
+	if (argc == 1) {
+		print_rom_mp5(shell);
+		return 0;
+	}
+
+	if (argc != 2) {
+		shell_error(shell, "%s", m_msg_invalid_args);
+		return -EINVAL;
+	}
+
+	if (strlen(argv[1]) != 2 * sizeof(m_app_config.rom_mp5)) {
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return -EINVAL;
+	}
+
+	ret = hex2bin(argv[1], strlen(argv[1]), m_app_config.rom_mp5, sizeof(m_app_config.rom_mp5));
+	if (!ret) {
+		LOG_ERR("Call `hex2bin` failed: %d", ret);
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return ret;
+	}
+
+	return 0;
+}
+
+static int cmd_rom_mp6(const struct shell *shell, size_t argc, char **argv)
+{
+	int ret;
+
+	if (argc == 1) {
+		print_rom_mp6(shell);
+		return 0;
+	}
+
+	if (argc != 2) {
+		shell_error(shell, "%s", m_msg_invalid_args);
+		return -EINVAL;
+	}
+
+	if (strlen(argv[1]) != 2 * sizeof(m_app_config.rom_mp6)) {
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return -EINVAL;
+	}
+
+	ret = hex2bin(argv[1], strlen(argv[1]), m_app_config.rom_mp6, sizeof(m_app_config.rom_mp6));
+	if (!ret) {
+		LOG_ERR("Call `hex2bin` failed: %d", ret);
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return ret;
+	}
+
+	return 0;
+}
+
+static int cmd_rom_mp7(const struct shell *shell, size_t argc, char **argv)
+{
+	int ret;
+
+	if (argc == 1) {
+		print_rom_mp7(shell);
+		return 0;
+	}
+
+	if (argc != 2) {
+		shell_error(shell, "%s", m_msg_invalid_args);
+		return -EINVAL;
+	}
+
+	if (strlen(argv[1]) != 2 * sizeof(m_app_config.rom_mp7)) {
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return -EINVAL;
+	}
+
+	ret = hex2bin(argv[1], strlen(argv[1]), m_app_config.rom_mp7, sizeof(m_app_config.rom_mp7));
+	if (!ret) {
+		LOG_ERR("Call `hex2bin` failed: %d", ret);
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return ret;
+	}
+
+	return 0;
+}
+
+static int cmd_rom_mp8(const struct shell *shell, size_t argc, char **argv)
+{
+	int ret;
+
+	if (argc == 1) {
+		print_rom_mp8(shell);
+		return 0;
+	}
+
+	if (argc != 2) {
+		shell_error(shell, "%s", m_msg_invalid_args);
+		return -EINVAL;
+	}
+
+	if (strlen(argv[1]) != 2 * sizeof(m_app_config.rom_mp8)) {
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return -EINVAL;
+	}
+
+	ret = hex2bin(argv[1], strlen(argv[1]), m_app_config.rom_mp8, sizeof(m_app_config.rom_mp8));
+	if (!ret) {
+		LOG_ERR("Call `hex2bin` failed: %d", ret);
+		shell_error(shell, "%s", m_msg_invalid_value);
+		return ret;
+	}
+
+	return 0;
+}
+
+static int cmd_cap_hall_left(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.cap_hall_left, print_cap_hall_left);
+}
+
+static int cmd_cap_hall_right(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.cap_hall_right, print_cap_hall_right);
+}
+
+static int cmd_cap_input_a(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.cap_input_a, print_cap_input_a);
+}
+
+static int cmd_cap_input_b(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.cap_input_b, print_cap_input_b);
+}
+
+static int cmd_cap_light_sensor(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.cap_light_sensor, print_cap_light_sensor);
+}
+
+static int cmd_cap_barometer(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.cap_barometer, print_cap_barometer);
+}
+
+static int cmd_cap_pir_detector(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.cap_pir_detector, print_cap_pir_detector);
+}
+
+static int cmd_cap_1w_thermometer(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.cap_1w_thermometer,
+			print_cap_1w_thermometer);
+}
+
+static int cmd_cap_1w_machine_probe(const struct shell *shell, size_t argc, char **argv)
+{
+	return cmd_bool(shell, argc, argv, &m_app_config.cap_1w_machine_probe,
+			print_cap_1w_machine_probe);
+}
+
+static int print_help(const struct shell *shell, size_t argc, char **argv)
+{
+	if (argc > 1) {
+		shell_error(shell, "command not found: %s", argv[1]);
+		shell_help(shell);
+		return -EINVAL;
+	}
+
+	shell_help(shell);
+
+	return 0;
+}
+
+/* clang-format off */
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+	sub_config,
+
+	SHELL_CMD_ARG(show, NULL,
+	              "Show all configuration.",
+	              cmd_show, 1, 0),
+
+	SHELL_CMD_ARG(secret-key, NULL,
+	              "Get/Set device secret key (32 hexadecimal digits).",
+	              cmd_secret_key, 1, 1),
+
+	SHELL_CMD_ARG(serial-number, NULL,
+	              "Get/Set device serial number (10 decimal digits).",
+	              cmd_serial_number, 1, 1),
+
+	SHELL_CMD_ARG(nonce-counter, NULL,
+	              "Get/Set nonce counter (unsigned integer).",
+	              cmd_nonce_counter, 1, 1),
+
+	SHELL_CMD_ARG(calibration, NULL,
+	              "Get/Set calibration mode (true/false).",
+	              cmd_calibration, 1, 1),
+
+	SHELL_CMD_ARG(interval-sample, NULL,
+	              "Get/Set sample interval (range 5 to 3600 seconds; 0 = precede report).",
+	              cmd_interval_sample, 1, 1),
+
+	SHELL_CMD_ARG(interval-sample-adaptive, NULL,
+	              "Get/Set adaptive sample interval (true/false).",
+	              cmd_interval_sample_adaptive, 1, 1),
+
+	SHELL_CMD_ARG(interval-sample-min, NULL,
+	              "Get/Set shortest adaptive sample interval (range 5 to 3600 seconds).",
+	              cmd_interval_sample_min, 1, 1),
+
+	SHELL_CMD_ARG(interval-sample-delta, NULL,
+	              "Get/Set adaptive sampling temperature step (range 0.1 to 10.0 deg. C).",
+	              cmd_interval_sample_delta, 1, 1),
+
+	SHELL_CMD_ARG(interval-aggreg, NULL,
+	              "Get/Set aggregation interval (range 60 to 86400 seconds; 0 = disabled).",
+	              cmd_interval_aggreg, 1, 1),
+
+	SHELL_CMD_ARG(interval-report, NULL,
+	              "Get/Set report interval (range 60 to 86400 seconds).",
+	              cmd_interval_report, 1, 1),
+
+	SHELL_CMD_ARG(report-batch, NULL,
+	              "Get/Set batched report of sample history (true/false).",
+	              cmd_report_batch, 1, 1),
+
+	SHELL_CMD_ARG(report-compress, NULL,
+	              "Get/Set delta compression of batched report and counters (true/false).",
+	              cmd_report_compress, 1, 1),
+
+	SHELL_CMD_ARG(report-delta, NULL,
+	              "Get/Set reporting only on change (true/false).",
+	              cmd_report_delta, 1, 1),
+
+	SHELL_CMD_ARG(report-delta-temperature, NULL,
+	              "Get/Set temperature change to report (range 0.1 to 10.0 deg. C).",
+	              cmd_report_delta_temperature, 1, 1),
+
+	SHELL_CMD_ARG(report-delta-humidity, NULL,
+	              "Get/Set humidity change to report (range 1.0 to 50.0 %).",
+	              cmd_report_delta_humidity, 1, 1),
+
+	SHELL_CMD_ARG(report-heartbeat, NULL,
+	              "Get/Set longest interval without report (range 600 to 86400 seconds).",
+	              cmd_report_heartbeat, 1, 1),
+
+	SHELL_CMD_ARG(lrw-region, NULL,
+	              "Get/Set LoRaWAN region (eu868/us915/au915).",
+	              cmd_lrw_region, 1, 1),
+
+	SHELL_CMD_ARG(lrw-network, NULL,
 	              "Get/Set LoRaWAN network (public/private).",
 	              cmd_lrw_network, 1, 1),
 
@@ -1837,6 +3240,78 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 	              "Get/Set T2 temperature hysteresis (0 to 5 deg. C).",
 	              cmd_alarm_t2_temperature_hst, 1, 1),
 
+	SHELL_CMD_ARG(alarm-illuminance-enabled, NULL,
+	              "Get/Set illuminance alarm enabled (true/false).",
+	              cmd_alarm_illuminance_enabled, 1, 1),
+
+	SHELL_CMD_ARG(alarm-illuminance-lo, NULL,
+	              "Get/Set illuminance low threshold (0 to 80000 lux).",
+	              cmd_alarm_illuminance_lo, 1, 1),
+
+	SHELL_CMD_ARG(alarm-illuminance-hi, NULL,
+	              "Get/Set illuminance high threshold (0 to 80000 lux).",
+	              cmd_alarm_illuminance_hi, 1, 1),
+
+	SHELL_CMD_ARG(alarm-illuminance-hst, NULL,
+	              "Get/Set illuminance hysteresis (0 to 1000 lux).",
+	              cmd_alarm_illuminance_hst, 1, 1),
+
+	SHELL_CMD_ARG(alarm-mp-temperature-enabled, NULL,
+	              "Get/Set machine probe temperature alarm enabled (true/false).",
+	              cmd_alarm_mp_temperature_enabled, 1, 1),
+
+	SHELL_CMD_ARG(alarm-mp-temperature-lo, NULL,
+	              "Get/Set machine probe temperature low threshold (-40 to 125 deg. C).",
+	              cmd_alarm_mp_temperature_lo, 1, 1),
+
+	SHELL_CMD_ARG(alarm-mp-temperature-hi, NULL,
+	              "Get/Set machine probe temperature high threshold (-40 to 125 deg. C).",
+	              cmd_alarm_mp_temperature_hi, 1, 1),
+
+	SHELL_CMD_ARG(alarm-mp-temperature-hst, NULL,
+	              "Get/Set machine probe temperature hysteresis (0 to 5 deg. C).",
+	              cmd_alarm_mp_temperature_hst, 1, 1),
+
+	SHELL_CMD_ARG(alarm-mp-humidity-enabled, NULL,
+	              "Get/Set machine probe humidity alarm enabled (true/false).",
+	              cmd_alarm_mp_humidity_enabled, 1, 1),
+
+	SHELL_CMD_ARG(alarm-mp-humidity-lo, NULL,
+	              "Get/Set machine probe humidity low threshold (0 to 100 %).",
+	              cmd_alarm_mp_humidity_lo, 1, 1),
+
+	SHELL_CMD_ARG(alarm-mp-humidity-hi, NULL,
+	              "Get/Set machine probe humidity high threshold (0 to 100 %).",
+	              cmd_alarm_mp_humidity_hi, 1, 1),
+
+	SHELL_CMD_ARG(alarm-mp-humidity-hst, NULL,
+	              "Get/Set machine probe humidity hysteresis (0 to 20 %).",
+	              cmd_alarm_mp_humidity_hst, 1, 1),
+
+	SHELL_CMD_ARG(alarm-notify, NULL,
+	              "Get/Set uplink on alarm activation/deactivation (true/false).",
+	              cmd_alarm_notify, 1, 1),
+
+	SHELL_CMD_ARG(alarm-roc-enabled, NULL,
+	              "Get/Set temperature rate-of-change alarm enabled (true/false).",
+	              cmd_alarm_roc_enabled, 1, 1),
+
+	SHELL_CMD_ARG(alarm-roc-rate, NULL,
+	              "Get/Set temperature rate-of-change threshold (0.1 to 10 deg. C/min).",
+	              cmd_alarm_roc_rate, 1, 1),
+
+	SHELL_CMD_ARG(alarm-roc-window, NULL,
+	              "Get/Set rate-of-change window in seconds (60-3600).",
+	              cmd_alarm_roc_window, 1, 1),
+
+	SHELL_CMD_ARG(alarm-stuck-enabled, NULL,
+	              "Get/Set stuck sensor alarm enabled (true/false).",
+	              cmd_alarm_stuck_enabled, 1, 1),
+
+	SHELL_CMD_ARG(alarm-stuck-samples, NULL,
+	              "Get/Set number of unchanged samples raising stuck sensor alarm (3-1000).",
+	              cmd_alarm_stuck_samples, 1, 1),
+
 	SHELL_CMD_ARG(hall-left-counter, NULL,
 	              "Get/Set hall left switch counter enabled (true/false).",
 	              cmd_hall_left_counter, 1, 1),
@@ -1849,6 +3324,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 	              "Get/Set hall left switch notify on deactivation (true/false).",
 	              cmd_hall_left_notify_deact, 1, 1),
 
+	SHELL_CMD_ARG(hall-left-interrupt, NULL,
+	              "Get/Set hall left switch edge interrupt instead of polling (true/false).",
+	              cmd_hall_left_interrupt, 1, 1),
+
 	SHELL_CMD_ARG(hall-right-counter, NULL,
 	              "Get/Set hall right switch counter enabled (true/false).",
 	              cmd_hall_right_counter, 1, 1),
@@ -1861,6 +3340,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 	              "Get/Set hall right switch notify on deactivation (true/false).",
 	              cmd_hall_right_notify_deact, 1, 1),
 
+	SHELL_CMD_ARG(hall-right-interrupt, NULL,
+	              "Get/Set hall right switch edge interrupt instead of polling (true/false).",
+	              cmd_hall_right_interrupt, 1, 1),
+
 	SHELL_CMD_ARG(input-a-counter, NULL,
 	              "Get/Set input A counter enabled (true/false).",
 	              cmd_input_a_counter, 1, 1),
@@ -1873,6 +3356,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 	              "Get/Set input A notify on deactivation (true/false).",
 	              cmd_input_a_notify_deact, 1, 1),
 
+	SHELL_CMD_ARG(input-a-interrupt, NULL,
+	              "Get/Set input A edge interrupt counting instead of polling (true/false).",
+	              cmd_input_a_interrupt, 1, 1),
+
 	SHELL_CMD_ARG(input-b-counter, NULL,
 	              "Get/Set input B counter enabled (true/false).",
 	              cmd_input_b_counter, 1, 1),
@@ -1885,6 +3372,14 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 	              "Get/Set input B notify on deactivation (true/false).",
 	              cmd_input_b_notify_deact, 1, 1),
 
+	SHELL_CMD_ARG(input-b-interrupt, NULL,
+	              "Get/Set input B edge interrupt counting instead of polling (true/false).",
+	              cmd_input_b_interrupt, 1, 1),
+
+	SHELL_CMD_ARG(input-debounce, NULL,
+	              "Get/Set input debounce time in milliseconds (0-1000).",
+	              cmd_input_debounce, 1, 1),
+
 	SHELL_CMD_ARG(corr-temperature, NULL,
 	              "Get/Set temperature correction (range -5.0 to +5.0 deg. C).",
 	              cmd_corr_temperature, 1, 1),
@@ -1897,6 +3392,78 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 	              "Get/Set T2 temperature correction (range -5.0 to +5.0 deg. C).",
 	              cmd_corr_t2_temperature, 1, 1),
 
+	SHELL_CMD_ARG(res-t1-temperature, NULL,
+	              "Get/Set T1 temperature resolution (range 9 to 12 bits).",
+	              cmd_res_t1_temperature, 1, 1),
+
+	SHELL_CMD_ARG(res-t2-temperature, NULL,
+	              "Get/Set T2 temperature resolution (range 9 to 12 bits).",
+	              cmd_res_t2_temperature, 1, 1),
+
+	SHELL_CMD_ARG(rom-t1, NULL,
+	              "Get/Set 1-Wire ROM bound to T1 thermometer (16 hex digits).",
+	              cmd_rom_t1, 1, 1),
+
+	SHELL_CMD_ARG(rom-t2, NULL,
+	              "Get/Set 1-Wire ROM bound to T2 thermometer (16 hex digits).",
+	              cmd_rom_t2, 1, 1),
+
+	SHELL_CMD_ARG(rom-t3, NULL,
+	              "Get/Set 1-Wire ROM bound to T3 thermometer (16 hex digits).",
+	              cmd_rom_t3, 1, 1),
+
+	SHELL_CMD_ARG(rom-t4, NULL,
+	              "Get/Set 1-Wire ROM bound to T4 thermometer (16 hex digits).",
+	              cmd_rom_t4, 1, 1),
+
+	SHELL_CMD_ARG(rom-t5, NULL,
+	              "Get/Set 1-Wire ROM bound to T5 thermometer (16 hex digits).",
+	              cmd_rom_t5, 1, 1),
+
+	SHELL_CMD_ARG(rom-t6, NULL,
+	              "Get/Set 1-Wire ROM bound to T6 thermometer (16 hex digits).",
+	              cmd_rom_t6, 1, 1),
+
+	SHELL_CMD_ARG(rom-t7, NULL,
+	              "Get/Set 1-Wire ROM bound to T7 thermometer (16 hex digits).",
+	              cmd_rom_t7, 1, 1),
+
+	SHELL_CMD_ARG(rom-t8, NULL,
+	              "Get/Set 1-Wire ROM bound to T8 thermometer (16 hex digits).",
+	              cmd_rom_t8, 1, 1),
+
+	SHELL_CMD_ARG(rom-mp1, NULL,
+	              "Get/Set 1-Wire ROM bound to machine probe 1 (16 hex digits).",
+	              cmd_rom_mp1, 1, 1),
+
+	SHELL_CMD_ARG(rom-mp2, NULL,
+	              "Get/Set 1-Wire ROM bound to machine probe 2 (16 hex digits).",
+	              cmd_rom_mp2, 1, 1),
+
+	SHELL_CMD_ARG(rom-mp3, NULL,
+	              "Get/Set 1-Wire ROM bound to machine probe 3 (16 hex digits).",
+	              cmd_rom_mp3, 1, 1),
+
+	SHELL_CMD_ARG(rom-mp4, NULL,
+	              "Get/Set 1-Wire ROM bound to machine probe 4 (16 hex digits).",
+	              cmd_rom_mp4, 1, 1),
+
+	SHELL_CMD_ARG(rom-mp5, NULL,
+	              "Get/Set 1-Wire ROM bound to machine probe 5 (16 hex digits).",
+	              cmd_rom_mp5, 1, 1),
+
+	SHELL_CMD_ARG(rom-mp6, NULL,
+	              "Get/Set 1-Wire ROM bound to machine probe 6 (16 hex digits).",
+	              cmd_rom_mp6, 1, 1),
+
+	SHELL_CMD_ARG(rom-mp7, NULL,
+	              "Get/Set 1-Wire ROM bound to machine probe 7 (16 hex digits).",
+	              cmd_rom_mp7, 1, 1),
+
+	SHELL_CMD_ARG(rom-mp8, NULL,
+	              "Get/Set 1-Wire ROM bound to machine probe 8 (16 hex digits).",
+	              cmd_rom_mp8, 1, 1),
+
 	SHELL_CMD_ARG(cap-hall-left, NULL,
 	              "Get/Set hall left capability (true/false).",
 	              cmd_cap_hall_left, 1, 1),
@@ -42,7 +42,17 @@ struct app_config {
 	uint32_t nonce_counter;
 	bool calibration;
 	int interval_sample;
+	bool interval_sample_adaptive;
+	int interval_sample_min;
+	float interval_sample_delta;
+	int interval_aggreg;
 	int interval_report;
+	bool report_batch;
+	bool report_compress;
+	bool report_delta;
+	float report_delta_temperature;
+	float report_delta_humidity;
+	int report_heartbeat;
 	enum app_config_lrw_region lrw_region;
 	enum app_config_lrw_network lrw_network;
 	bool lrw_adr;
@@ -74,21 +84,62 @@ struct app_config {
 	float alarm_t2_temperature_lo;
 	float alarm_t2_temperature_hi;
 	float alarm_t2_temperature_hst;
+	bool alarm_illuminance_enabled;
+	float alarm_illuminance_lo;
+	float alarm_illuminance_hi;
+	float alarm_illuminance_hst;
+	bool alarm_mp_temperature_enabled;
+	float alarm_mp_temperature_lo;
+	float alarm_mp_temperature_hi;
+	float alarm_mp_temperature_hst;
+	bool alarm_mp_humidity_enabled;
+	float alarm_mp_humidity_lo;
+	float alarm_mp_humidity_hi;
+	float alarm_mp_humidity_hst;
+	bool alarm_notify;
+	bool alarm_roc_enabled;
+	float alarm_roc_rate;
+	int alarm_roc_window;
+	bool alarm_stuck_enabled;
+	int alarm_stuck_samples;
 	bool hall_left_counter;
 	bool hall_left_notify_act;
 	bool hall_left_notify_deact;
+	bool hall_left_interrupt;
 	bool hall_right_counter;
 	bool hall_right_notify_act;
 	bool hall_right_notify_deact;
+	bool hall_right_interrupt;
 	bool input_a_counter;
 	bool input_a_notify_act;
 	bool input_a_notify_deact;
+	bool input_a_interrupt;
 	bool input_b_counter;
 	bool input_b_notify_act;
 	bool input_b_notify_deact;
+	bool input_b_interrupt;
+	int input_debounce;
 	float corr_temperature;
 	float corr_t1_temperature;
 	float corr_t2_temperature;
+	int res_t1_temperature;
+	int res_t2_temperature;
+	uint8_t rom_t1[8];
+	uint8_t rom_t2[8];
+	uint8_t rom_t3[8];
+	uint8_t rom_t4[8];
+	uint8_t rom_t5[8];
+	uint8_t rom_t6[8];
+	uint8_t rom_t7[8];
+	uint8_t rom_t8[8];
+	uint8_t rom_mp1[8];
+	uint8_t rom_mp2[8];
+	uint8_t rom_mp3[8];
+	uint8_t rom_mp4[8];
+	uint8_t rom_mp5[8];
+	uint8_t rom_mp6[8];
+	uint8_t rom_mp7[8];
+	uint8_t rom_mp8[8];
 	bool cap_hall_left;
 	bool cap_hall_right;
 	bool cap_input_a;
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "app_config.h"
 #include "app_ds18b20.h"
 #include "app_log.h"
 #include "app_w1.h"
@@ -20,59 +21,215 @@
 
 /* Standard includes */
 #include <errno.h>
+#include <math.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
 LOG_MODULE_REGISTER(app_ds18b20, LOG_LEVEL_DBG);
 
+#define CMD_CONVERT_T        0x44
+#define CMD_WRITE_SCRATCHPAD 0x4e
+#define CMD_COPY_SCRATCHPAD  0x48
+#define CMD_READ_SCRATCHPAD  0xbe
+
+#define SCRATCHPAD_SIZE 9
+#define SCRATCHPAD_TH   2
+#define SCRATCHPAD_TL   3
+#define SCRATCHPAD_CFG  4
+
+/* EEPROM write time of the copy scratchpad command */
+#define COPY_TIME K_MSEC(10)
+
+/* Conversion time halves with every bit of resolution below 12 bits (750 ms) */
+#define CONVERSION_TIME_USEC(resolution) (750000 >> (12 - (resolution)))
+
 struct sensor {
 	uint64_t serial_number;
-	const struct device *dev;
+	struct w1_rom rom;
+	int resolution;
+	bool is_present;
 };
 
 static K_MUTEX_DEFINE(m_lock);
 
 static struct app_w1 m_w1;
 
-static struct sensor m_sensors[] = {
-	{.dev = DEVICE_DT_GET(DT_NODELABEL(ds18b20_0))},
-	{.dev = DEVICE_DT_GET(DT_NODELABEL(ds18b20_1))},
+/* Single sensor driver instance, pointed at the probe being read */
+static const struct device *m_sensor_dev = DEVICE_DT_GET(DT_NODELABEL(ds18b20));
+
+static struct sensor m_sensors[CONFIG_APP_DS18B20_COUNT];
+
+/* Slot of each sensor, bound to the probe ROM in the configuration */
+static const struct app_w1_binding m_bindings[] = {
+	{.key = "config/rom-t1", .offset = offsetof(struct app_config, rom_t1)},
+	{.key = "config/rom-t2", .offset = offsetof(struct app_config, rom_t2)},
+	{.key = "config/rom-t3", .offset = offsetof(struct app_config, rom_t3)},
+	{.key = "config/rom-t4", .offset = offsetof(struct app_config, rom_t4)},
+	{.key = "config/rom-t5", .offset = offsetof(struct app_config, rom_t5)},
+	{.key = "config/rom-t6", .offset = offsetof(struct app_config, rom_t6)},
+	{.key = "config/rom-t7", .offset = offsetof(struct app_config, rom_t7)},
+	{.key = "config/rom-t8", .offset = offsetof(struct app_config, rom_t8)},
 };
 
+BUILD_ASSERT(ARRAY_SIZE(m_sensors) <= ARRAY_SIZE(m_bindings));
+
+/* Number of slots up to the last one with a probe present */
 static int m_count;
 
-static int scan_callback(struct w1_rom rom, void *user_data)
+static int get_resolution(const uint8_t *scratchpad)
+{
+	return 9 + ((scratchpad[SCRATCHPAD_CFG] >> 5) & 0x03);
+}
+
+static float get_temperature(const uint8_t *scratchpad)
+{
+	/* Bits below the configured resolution are undefined */
+	int resolution = get_resolution(scratchpad);
+	int16_t raw = sys_get_le16(scratchpad) & ~((1 << (12 - resolution)) - 1);
+
+	return raw / 16.f;
+}
+
+static int read_scratchpad(const struct device *dev, const struct w1_rom *rom, uint8_t *buf)
 {
 	int ret;
 
-	if (rom.family != 0x28) {
-		return 0;
+	const struct w1_slave_config config = {.rom = *rom};
+
+	ret = w1_match_rom(dev, &config);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("w1_match_rom", ret);
+		return ret;
 	}
 
-	uint64_t serial_number = sys_get_le48(rom.serial);
+	ret = w1_write_byte(dev, CMD_READ_SCRATCHPAD);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("w1_write_byte", ret);
+		return ret;
+	}
+
+	ret = w1_read_block(dev, buf, SCRATCHPAD_SIZE);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("w1_read_block", ret);
+		return ret;
+	}
 
-	if (m_count >= ARRAY_SIZE(m_sensors)) {
-		LOG_WRN("No more space for additional device: %llu", serial_number);
+	if (w1_crc8(buf, SCRATCHPAD_SIZE - 1) != buf[SCRATCHPAD_SIZE - 1]) {
+		LOG_ERR("Scratchpad CRC mismatch");
+		return -EIO;
+	}
+
+	return 0;
+}
+
+/* Write the resolution (keeping the alarm thresholds), optionally persist it in EEPROM */
+static int write_resolution(const struct device *dev, const struct w1_rom *rom,
+			    const uint8_t *scratchpad, int resolution, bool persist)
+{
+	int ret;
+
+	const struct w1_slave_config config = {.rom = *rom};
+
+	ret = w1_match_rom(dev, &config);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("w1_match_rom", ret);
+		return ret;
+	}
+
+	const uint8_t buf[] = {
+		CMD_WRITE_SCRATCHPAD,
+		scratchpad[SCRATCHPAD_TH],
+		scratchpad[SCRATCHPAD_TL],
+		((resolution - 9) << 5) | 0x1f,
+	};
+
+	ret = w1_write_block(dev, buf, sizeof(buf));
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("w1_write_block", ret);
+		return ret;
+	}
+
+	if (!persist) {
 		return 0;
 	}
 
-	if (!device_is_ready(m_sensors[m_count].dev)) {
-		LOG_ERR("Device not ready");
-		return -ENODEV;
+	ret = w1_match_rom(dev, &config);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("w1_match_rom", ret);
+		return ret;
 	}
 
-	struct sensor_value val;
-	w1_rom_to_sensor_value(&rom, &val);
+	ret = w1_write_byte(dev, CMD_COPY_SCRATCHPAD);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("w1_write_byte", ret);
+		return ret;
+	}
+
+	k_sleep(COPY_TIME);
+
+	return 0;
+}
+
+static int configure(const struct device *dev, struct sensor *sensor, int resolution)
+{
+	int ret;
 
-	ret = sensor_attr_set(m_sensors[m_count].dev, SENSOR_CHAN_ALL, SENSOR_ATTR_W1_ROM, &val);
+	uint8_t scratchpad[SCRATCHPAD_SIZE];
+	ret = read_scratchpad(dev, &sensor->rom, scratchpad);
 	if (ret) {
-		LOG_ERR_CALL_FAILED_INT("sensor_attr_set", ret);
+		LOG_ERR_CALL_FAILED_INT("read_scratchpad", ret);
 		return ret;
 	}
 
-	m_sensors[m_count++].serial_number = serial_number;
+	/* Persisted, so it survives the probe losing power (EEPROM written on change only) */
+	if (get_resolution(scratchpad) != resolution) {
+		ret = write_resolution(dev, &sensor->rom, scratchpad, resolution, true);
+		if (ret) {
+			LOG_ERR_CALL_FAILED_INT("write_resolution", ret);
+			return ret;
+		}
+	}
+
+	sensor->resolution = resolution;
+
+	LOG_DBG("Resolution: %d bits", resolution);
+
+	return 0;
+}
+
+/* Slots beyond T2 have no resolution parameter and convert at full resolution */
+static int get_slot_resolution(int index)
+{
+	switch (index) {
+	case 0:
+		return g_app_config.res_t1_temperature;
+	case 1:
+		return g_app_config.res_t2_temperature;
+	default:
+		return 12;
+	}
+}
+
+static int register_sensor(const struct device *dev, int index, struct w1_rom rom)
+{
+	int ret;
+
+	struct sensor *sensor = &m_sensors[index];
+	uint64_t serial_number = sys_get_le48(rom.serial);
+
+	sensor->rom = rom;
+	sensor->serial_number = serial_number;
+
+	LOG_DBG("Registered serial number: %llu (slot: %d)", serial_number, index);
+
+	ret = configure(dev, sensor, get_slot_resolution(index));
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("configure", ret);
+		sensor->resolution = 12;
+	}
 
-	LOG_DBG("Registered serial number: %llu", serial_number);
+	sensor->is_present = true;
 
 	return 0;
 }
@@ -105,12 +262,53 @@ int app_ds18b20_scan(void)
 
 	m_count = 0;
 
-	ret = app_w1_scan(&m_w1, dev, scan_callback, NULL);
+	for (int i = 0; i < ARRAY_SIZE(m_sensors); i++) {
+		m_sensors[i].is_present = false;
+	}
+
+	struct w1_rom roms[APP_W1_SCAN_MAX];
+
+	ret = app_w1_scan(&m_w1, dev, roms, ARRAY_SIZE(roms), NULL, NULL);
 	if (ret < 0) {
 		LOG_ERR_CALL_FAILED_INT("app_w1_scan", ret);
 		res = ret;
+		goto error;
+	}
+
+	/* Thermometers only, in search order */
+	int count = 0;
+
+	for (int i = 0; i < MIN(ret, (int)ARRAY_SIZE(roms)); i++) {
+		if (roms[i].family == 0x28) {
+			roms[count++] = roms[i];
+		}
+	}
+
+	/* Resolved once here, the sampling path indexes the sensors by slot directly */
+	int slots[ARRAY_SIZE(m_sensors)];
+
+	ret = app_w1_bind(m_bindings, slots, ARRAY_SIZE(m_sensors), roms, count);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("app_w1_bind", ret);
+		res = ret;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(m_sensors); i++) {
+		if (slots[i] < 0) {
+			continue;
+		}
+
+		ret = register_sensor(dev, i, roms[slots[i]]);
+		if (ret) {
+			LOG_ERR_CALL_FAILED_INT("register_sensor", ret);
+			res = res ? res : ret;
+			continue;
+		}
+
+		m_count = i + 1;
 	}
 
+error:
 	ret = app_w1_release(&m_w1, dev);
 	if (ret) {
 		LOG_ERR_CALL_FAILED_INT("app_w1_release", ret);
@@ -135,6 +333,35 @@ int app_ds18b20_get_count(void)
 	return count;
 }
 
+/* Point the sensor driver instance at the probe, at the resolution the probe is configured to */
+static int select_sensor(const struct sensor *sensor)
+{
+	int ret;
+
+	if (!device_is_ready(m_sensor_dev)) {
+		LOG_ERR("Device not ready");
+		return -ENODEV;
+	}
+
+	struct sensor_value val;
+	w1_rom_to_sensor_value(&sensor->rom, &val);
+
+	ret = sensor_attr_set(m_sensor_dev, SENSOR_CHAN_ALL, SENSOR_ATTR_W1_ROM, &val);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("sensor_attr_set", ret);
+		return ret;
+	}
+
+	val = (struct sensor_value){.val1 = sensor->resolution};
+
+	ret = sensor_attr_set(m_sensor_dev, SENSOR_CHAN_ALL, SENSOR_ATTR_RESOLUTION, &val);
+	if (ret) {
+		LOG_WRN("Call `sensor_attr_set` failed: %d", ret);
+	}
+
+	return 0;
+}
+
 int app_ds18b20_read(int index, uint64_t *serial_number, float *temperature)
 {
 	int ret;
@@ -151,6 +378,11 @@ int app_ds18b20_read(int index, uint64_t *serial_number, float *temperature)
 		return -ERANGE;
 	}
 
+	if (!m_sensors[index].is_present) {
+		k_mutex_unlock(&m_lock);
+		return -ENODEV;
+	}
+
 	static const struct device *dev = DEVICE_DT_GET(DT_NODELABEL(ds2484));
 
 	if (!device_is_ready(dev)) {
@@ -170,13 +402,14 @@ int app_ds18b20_read(int index, uint64_t *serial_number, float *temperature)
 		return ret;
 	}
 
-	if (!device_is_ready(m_sensors[index].dev)) {
-		LOG_ERR("Device not ready");
-		res = -ENODEV;
+	ret = select_sensor(&m_sensors[index]);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("select_sensor", ret);
+		res = ret;
 		goto error;
 	}
 
-	ret = sensor_sample_fetch(m_sensors[index].dev);
+	ret = sensor_sample_fetch(m_sensor_dev);
 	if (ret) {
 		LOG_ERR_CALL_FAILED_INT("sensor_sample_fetch", ret);
 		res = ret;
@@ -184,7 +417,7 @@ int app_ds18b20_read(int index, uint64_t *serial_number, float *temperature)
 	}
 
 	struct sensor_value val;
-	ret = sensor_channel_get(m_sensors[index].dev, SENSOR_CHAN_AMBIENT_TEMP, &val);
+	ret = sensor_channel_get(m_sensor_dev, SENSOR_CHAN_AMBIENT_TEMP, &val);
 	if (ret) {
 		LOG_ERR_CALL_FAILED_INT("sensor_channel_get", ret);
 		res = ret;
@@ -210,3 +443,123 @@ error:
 
 	return res;
 }
+
+int app_ds18b20_read_all(uint64_t *serial_numbers, float *temperatures, int count)
+{
+	int ret;
+	int res = 0;
+
+	if (k_is_in_isr()) {
+		return -EWOULDBLOCK;
+	}
+
+	for (int i = 0; i < count; i++) {
+		temperatures[i] = NAN;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	if (!m_count) {
+		k_mutex_unlock(&m_lock);
+		return 0;
+	}
+
+	static const struct device *dev = DEVICE_DT_GET(DT_NODELABEL(ds2484));
+
+	if (!device_is_ready(dev)) {
+		LOG_ERR("Device not ready");
+		k_mutex_unlock(&m_lock);
+		return -ENODEV;
+	}
+
+	ret = app_w1_acquire(&m_w1, dev);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("app_w1_acquire", ret);
+		k_mutex_unlock(&m_lock);
+		return ret;
+	}
+
+	/* Start the conversion on all sensors at once */
+	const struct w1_slave_config config = {.overdrive = 0};
+
+	ret = w1_skip_rom(dev, &config);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("w1_skip_rom", ret);
+		res = ret;
+		goto error;
+	}
+
+	ret = w1_write_byte(dev, CMD_CONVERT_T);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("w1_write_byte", ret);
+		res = ret;
+		goto error;
+	}
+
+	/* Wait for the sensor with the finest resolution */
+	int conversion_time = 0;
+
+	for (int i = 0; i < m_count; i++) {
+		if (!m_sensors[i].is_present) {
+			continue;
+		}
+
+		int resolution = m_sensors[i].resolution;
+
+		conversion_time = MAX(conversion_time, CONVERSION_TIME_USEC(resolution));
+	}
+
+	k_sleep(K_USEC(conversion_time));
+
+	for (int i = 0; i < MIN(m_count, count); i++) {
+		struct sensor *sensor = &m_sensors[i];
+
+		if (!sensor->is_present) {
+			continue;
+		}
+
+		if (serial_numbers) {
+			serial_numbers[i] = sensor->serial_number;
+		}
+
+		uint8_t scratchpad[SCRATCHPAD_SIZE];
+		ret = read_scratchpad(dev, &sensor->rom, scratchpad);
+		if (ret) {
+			LOG_ERR_CALL_FAILED_INT("read_scratchpad", ret);
+			res = res ? res : ret;
+			continue;
+		}
+
+		/* Resolution changed behind our back, restore it for the next conversion */
+		if (get_resolution(scratchpad) != sensor->resolution) {
+			LOG_WRN("Unexpected resolution: %d bits", get_resolution(scratchpad));
+
+			ret = write_resolution(dev, &sensor->rom, scratchpad, sensor->resolution,
+					       false);
+			if (ret) {
+				LOG_ERR_CALL_FAILED_INT("write_resolution", ret);
+				res = res ? res : ret;
+			}
+
+			/* Conversion at a finer resolution was not waited for */
+			if (get_resolution(scratchpad) > sensor->resolution) {
+				continue;
+			}
+		}
+
+		temperatures[i] = get_temperature(scratchpad);
+
+		LOG_DBG("Temperature: %.2f C", (double)temperatures[i]);
+	}
+
+error:
+	ret = app_w1_release(&m_w1, dev);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("app_w1_release", ret);
+		res = res ? res : ret;
+	}
+
+	k_mutex_unlock(&m_lock);
+
+	return res;
+}
@@ -15,9 +15,13 @@ extern "C" {
 #endif
 
 int app_ds18b20_scan(void);
+/* Sensors are indexed by the slot bound to their ROM, slots without a probe read -ENODEV */
 int app_ds18b20_get_count(void);
 int app_ds18b20_read(int index, uint64_t *serial_number, float *temperature);
 
+/* Convert all sensors at once and read them, temperatures of failed sensors are NAN */
+int app_ds18b20_read_all(uint64_t *serial_numbers, float *temperatures, int count);
+
 #ifdef __cplusplus
 }
 #endif
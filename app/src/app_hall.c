@@ -16,6 +16,7 @@
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
 
 /* Standard includes */
 #include <errno.h>
@@ -24,16 +25,29 @@
 
 LOG_MODULE_REGISTER(app_hall, LOG_LEVEL_DBG);
 
+#define POLL_INTERVAL_MSEC 100
+#define DEBOUNCE_MSEC      20
+
 static const struct gpio_dt_spec m_hall_left = GPIO_DT_SPEC_GET(DT_ALIAS(sw0), gpios);
 static const struct gpio_dt_spec m_hall_right = GPIO_DT_SPEC_GET(DT_ALIAS(sw1), gpios);
 
 static struct app_hall_data m_hall_data;
 
+/* Switches read on edge interrupt (kept pulled up) instead of periodic strobing */
+static bool m_is_left_interrupt;
+static bool m_is_right_interrupt;
+
+static struct gpio_callback m_hall_left_cb;
+static struct gpio_callback m_hall_right_cb;
+
+/* Timer and interrupt wakeups since boot */
+static atomic_t m_wakeups;
+
 K_MUTEX_DEFINE(m_hall_data_mutex);
 
 static int poll(void)
 {
-	int ret;
+	int ret = 0;
 
 	bool left_was_active;
 	bool left_is_active;
@@ -54,7 +68,11 @@ static int poll(void)
 		right_is_active = false;
 	}
 
-	if (g_app_config.cap_hall_left) {
+	/* Pull-up only for the time of reading unless read on interrupt */
+	bool strobe_left = g_app_config.cap_hall_left && !m_is_left_interrupt;
+	bool strobe_right = g_app_config.cap_hall_right && !m_is_right_interrupt;
+
+	if (strobe_left) {
 		ret = gpio_pin_configure_dt(&m_hall_left, GPIO_INPUT | GPIO_PULL_UP);
 		if (ret) {
 			LOG_ERR_CALL_FAILED_INT("gpio_pin_configure_dt", ret);
@@ -62,7 +80,7 @@ static int poll(void)
 		}
 	}
 
-	if (g_app_config.cap_hall_right) {
+	if (strobe_right) {
 		ret = gpio_pin_configure_dt(&m_hall_right, GPIO_INPUT | GPIO_PULL_UP);
 		if (ret) {
 			LOG_ERR_CALL_FAILED_INT("gpio_pin_configure_dt", ret);
@@ -70,7 +88,9 @@ static int poll(void)
 		}
 	}
 
-	k_busy_wait(2);
+	if (strobe_left || strobe_right) {
+		k_busy_wait(2);
+	}
 
 	if (g_app_config.cap_hall_left) {
 		int val = gpio_pin_get_dt(&m_hall_left);
@@ -93,7 +113,7 @@ static int poll(void)
 	}
 
 restore:
-	if (g_app_config.cap_hall_left) {
+	if (strobe_left) {
 		int err = gpio_pin_configure_dt(&m_hall_left, GPIO_INPUT | GPIO_PULL_DOWN);
 		if (err) {
 			LOG_ERR_CALL_FAILED_INT("gpio_pin_configure_dt", err);
@@ -103,7 +123,7 @@ restore:
 		}
 	}
 
-	if (g_app_config.cap_hall_right) {
+	if (strobe_right) {
 		int err = gpio_pin_configure_dt(&m_hall_right, GPIO_INPUT | GPIO_PULL_DOWN);
 		if (err) {
 			LOG_ERR_CALL_FAILED_INT("gpio_pin_configure_dt", err);
@@ -202,14 +222,52 @@ static void hall_poll_work_handler(struct k_work *work)
 }
 
 static K_WORK_DEFINE(m_hall_poll_work, hall_poll_work_handler);
+static K_WORK_DELAYABLE_DEFINE(m_hall_debounce_work, hall_poll_work_handler);
 
 static void hall_timer_handler(struct k_timer *timer)
 {
+	atomic_inc(&m_wakeups);
+
 	k_work_submit(&m_hall_poll_work);
 }
 
 static K_TIMER_DEFINE(m_hall_timer, hall_timer_handler, NULL);
 
+static void hall_gpio_callback(const struct device *dev, struct gpio_callback *cb, uint32_t pins)
+{
+	atomic_inc(&m_wakeups);
+
+	/* Read once the contacts settle (every bounce restarts the delay) */
+	k_work_reschedule(&m_hall_debounce_work, K_MSEC(DEBOUNCE_MSEC));
+}
+
+static int setup_interrupt(const struct gpio_dt_spec *spec, struct gpio_callback *cb)
+{
+	int ret;
+
+	ret = gpio_pin_configure_dt(spec, GPIO_INPUT | GPIO_PULL_UP);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("gpio_pin_configure_dt", ret);
+		return ret;
+	}
+
+	gpio_init_callback(cb, hall_gpio_callback, BIT(spec->pin));
+
+	ret = gpio_add_callback_dt(spec, cb);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("gpio_add_callback_dt", ret);
+		return ret;
+	}
+
+	ret = gpio_pin_interrupt_configure_dt(spec, GPIO_INT_EDGE_BOTH);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("gpio_pin_interrupt_configure_dt", ret);
+		return ret;
+	}
+
+	return 0;
+}
+
 int app_hall_init(void)
 {
 	int ret;
@@ -236,7 +294,36 @@ int app_hall_init(void)
 		return ret;
 	}
 
-	k_timer_start(&m_hall_timer, K_MSEC(100), K_MSEC(100));
+	m_is_left_interrupt = g_app_config.cap_hall_left && g_app_config.hall_left_interrupt;
+	m_is_right_interrupt = g_app_config.cap_hall_right && g_app_config.hall_right_interrupt;
+
+	if (m_is_left_interrupt) {
+		ret = setup_interrupt(&m_hall_left, &m_hall_left_cb);
+		if (ret) {
+			LOG_ERR_CALL_FAILED_INT("setup_interrupt", ret);
+			return ret;
+		}
+	}
+
+	if (m_is_right_interrupt) {
+		ret = setup_interrupt(&m_hall_right, &m_hall_right_cb);
+		if (ret) {
+			LOG_ERR_CALL_FAILED_INT("setup_interrupt", ret);
+			return ret;
+		}
+	}
+
+	/* Initial state of the switches read on interrupt */
+	if (m_is_left_interrupt || m_is_right_interrupt) {
+		k_work_reschedule(&m_hall_debounce_work, K_MSEC(DEBOUNCE_MSEC));
+	}
+
+	/* Periodic strobing only for the switches without interrupt */
+	if ((g_app_config.cap_hall_left && !m_is_left_interrupt) ||
+	    (g_app_config.cap_hall_right && !m_is_right_interrupt)) {
+		k_timer_start(&m_hall_timer, K_MSEC(POLL_INTERVAL_MSEC),
+			      K_MSEC(POLL_INTERVAL_MSEC));
+	}
 
 	return 0;
 }
@@ -317,3 +404,15 @@ bool app_hall_check_notify_event(void)
 
 	return has_event;
 }
+
+int app_hall_get_wakeups(uint32_t *wakeups, uint32_t *seconds)
+{
+	if (!wakeups || !seconds) {
+		return -EINVAL;
+	}
+
+	*wakeups = (uint32_t)atomic_get(&m_wakeups);
+	*seconds = (uint32_t)(k_uptime_get() / 1000);
+
+	return 0;
+}
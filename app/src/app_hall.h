@@ -32,6 +32,7 @@ int app_hall_get_data_and_clear_notify(struct app_hall_data *data);
 void app_hall_clear_notify_flags(struct app_hall_data *data);
 bool app_hall_check_notify_event(void);
 void app_hall_reset_counts(void);
+int app_hall_get_wakeups(uint32_t *wakeups, uint32_t *seconds);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2025 HARDWARIO a.s.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "app_history.h"
+
+/* Zephyr includes */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+/* Standard includes */
+#include <errno.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(app_history, LOG_LEVEL_DBG);
+
+static K_MUTEX_DEFINE(m_lock);
+
+static struct app_history_sample m_samples[CONFIG_APP_HISTORY_SIZE];
+static int m_head;
+static int m_count;
+
+void app_history_push(const struct app_history_sample *sample)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	memcpy(&m_samples[m_head], sample, sizeof(m_samples[m_head]));
+
+	m_head = (m_head + 1) % ARRAY_SIZE(m_samples);
+
+	if (m_count < ARRAY_SIZE(m_samples)) {
+		m_count++;
+	}
+
+	k_mutex_unlock(&m_lock);
+}
+
+/* Keep indices stable across multiple calls (the lock is recursive) */
+void app_history_lock(void)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+}
+
+void app_history_unlock(void)
+{
+	k_mutex_unlock(&m_lock);
+}
+
+int app_history_get_count(void)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+	int count = m_count;
+	k_mutex_unlock(&m_lock);
+
+	return count;
+}
+
+/* Index 0 is the oldest sample */
+int app_history_get(int index, struct app_history_sample *sample)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	if (index < 0 || index >= m_count) {
+		k_mutex_unlock(&m_lock);
+		return -ERANGE;
+	}
+
+	int pos = (m_head + ARRAY_SIZE(m_samples) - m_count + index) % ARRAY_SIZE(m_samples);
+
+	memcpy(sample, &m_samples[pos], sizeof(*sample));
+
+	k_mutex_unlock(&m_lock);
+
+	return 0;
+}
+
+/* Aggregate samples with timestamp in interval (since, until], returns number of samples */
+int app_history_aggregate(uint32_t since, uint32_t until,
+			  struct app_history_stats stats[APP_HISTORY_CHANNEL_COUNT])
+{
+	int count = 0;
+	float sum[APP_HISTORY_CHANNEL_COUNT] = {0};
+
+	for (int i = 0; i < APP_HISTORY_CHANNEL_COUNT; i++) {
+		stats[i].min = NAN;
+		stats[i].max = NAN;
+		stats[i].mean = NAN;
+		stats[i].last = NAN;
+		stats[i].count = 0;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	/* Walk from the oldest sample so that the last valid value wins */
+	for (int i = 0; i < m_count; i++) {
+		int pos = (m_head + ARRAY_SIZE(m_samples) - m_count + i) % ARRAY_SIZE(m_samples);
+		const struct app_history_sample *sample = &m_samples[pos];
+
+		if (sample->timestamp <= since || sample->timestamp > until) {
+			continue;
+		}
+
+		count++;
+
+		for (int j = 0; j < APP_HISTORY_CHANNEL_COUNT; j++) {
+			float value = sample->values[j];
+
+			if (isnan(value)) {
+				continue;
+			}
+
+			if (!stats[j].count || value < stats[j].min) {
+				stats[j].min = value;
+			}
+
+			if (!stats[j].count || value > stats[j].max) {
+				stats[j].max = value;
+			}
+
+			stats[j].last = value;
+			stats[j].count++;
+			sum[j] += value;
+		}
+	}
+
+	k_mutex_unlock(&m_lock);
+
+	for (int i = 0; i < APP_HISTORY_CHANNEL_COUNT; i++) {
+		if (stats[i].count) {
+			stats[i].mean = sum[i] / stats[i].count;
+		}
+	}
+
+	return count;
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2025 HARDWARIO a.s.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APP_HISTORY_H_
+#define APP_HISTORY_H_
+
+/* Standard includes */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum app_history_channel {
+	APP_HISTORY_CHANNEL_VOLTAGE = 0,
+	APP_HISTORY_CHANNEL_TEMPERATURE = 1,
+	APP_HISTORY_CHANNEL_HUMIDITY = 2,
+	APP_HISTORY_CHANNEL_ILLUMINANCE = 3,
+	APP_HISTORY_CHANNEL_T1_TEMPERATURE = 4,
+	APP_HISTORY_CHANNEL_T2_TEMPERATURE = 5,
+	APP_HISTORY_CHANNEL_ALTITUDE = 6,
+	APP_HISTORY_CHANNEL_PRESSURE = 7,
+	APP_HISTORY_CHANNEL_MP1_TEMPERATURE = 8,
+	APP_HISTORY_CHANNEL_MP2_TEMPERATURE = 9,
+	APP_HISTORY_CHANNEL_MP1_HUMIDITY = 10,
+	APP_HISTORY_CHANNEL_MP2_HUMIDITY = 11,
+	APP_HISTORY_CHANNEL_COUNT = 12,
+};
+
+struct app_history_sample {
+	/* Uptime in seconds */
+	uint32_t timestamp;
+	/* NAN if channel not available */
+	float values[APP_HISTORY_CHANNEL_COUNT];
+};
+
+struct app_history_stats {
+	float min;
+	float max;
+	float mean;
+	float last;
+	int count;
+};
+
+void app_history_push(const struct app_history_sample *sample);
+void app_history_lock(void);
+void app_history_unlock(void);
+int app_history_get_count(void);
+int app_history_get(int index, struct app_history_sample *sample);
+int app_history_aggregate(uint32_t since, uint32_t until,
+			  struct app_history_stats stats[APP_HISTORY_CHANNEL_COUNT]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_HISTORY_H_ */
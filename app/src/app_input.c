@@ -12,9 +12,11 @@
 /* Zephyr includes */
 #include <zephyr/device.h>
 #include <zephyr/devicetree.h>
+#include <zephyr/drivers/counter.h>
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
 
 /* Standard includes */
 #include <errno.h>
@@ -23,100 +25,201 @@
 
 LOG_MODULE_REGISTER(app_input, LOG_LEVEL_DBG);
 
+#define POLL_INTERVAL_MSEC 100
+
+#if defined(CONFIG_APP_INPUT_COUNTER) && DT_NODE_EXISTS(DT_ALIAS(input_a_counter))
+#define INPUT_A_COUNTER DEVICE_DT_GET(DT_ALIAS(input_a_counter))
+#else
+#define INPUT_A_COUNTER NULL
+#endif
+
+#if defined(CONFIG_APP_INPUT_COUNTER) && DT_NODE_EXISTS(DT_ALIAS(input_b_counter))
+#define INPUT_B_COUNTER DEVICE_DT_GET(DT_ALIAS(input_b_counter))
+#else
+#define INPUT_B_COUNTER NULL
+#endif
+
+/* Edge state shared between the interrupt handler and the work queue */
+struct input {
+	const char *name;
+	const struct gpio_dt_spec *spec;
+	struct gpio_callback cb;
+	/* Hardware pulse counter, read out only when the data is cleared */
+	const struct device *counter;
+	uint32_t counter_value;
+	bool is_counter;
+	bool is_interrupt;
+	bool is_active;
+	int64_t last_edge;
+	int64_t last_pulse;
+	uint32_t activations;
+	uint32_t deactivations;
+	uint32_t pulses;
+	uint32_t period_min;
+	uint32_t period_max;
+};
+
 static const struct gpio_dt_spec m_input_a = GPIO_DT_SPEC_GET(DT_ALIAS(sw2), gpios);
 static const struct gpio_dt_spec m_input_b = GPIO_DT_SPEC_GET(DT_ALIAS(sw3), gpios);
 
+static struct input m_a = {
+	.name = "A",
+	.spec = &m_input_a,
+	.counter = INPUT_A_COUNTER,
+	.period_min = UINT32_MAX,
+	.period_max = UINT32_MAX,
+};
+
+static struct input m_b = {
+	.name = "B",
+	.spec = &m_input_b,
+	.counter = INPUT_B_COUNTER,
+	.period_min = UINT32_MAX,
+	.period_max = UINT32_MAX,
+};
+
+static struct k_spinlock m_lock;
+
+/* Start of the current pulse statistics interval */
+static int64_t m_pulse_since;
+
 static struct app_input_data m_input_data;
 
 K_MUTEX_DEFINE(m_input_data_mutex);
 
-static int poll(void)
+/* Must be called with m_lock held */
+static void update(struct input *input, bool is_active, int64_t now)
 {
-	bool input_a_was_active;
-	bool input_a_is_active;
-
-	bool input_b_was_active;
-	bool input_b_is_active;
+	if (input->is_active == is_active) {
+		return;
+	}
 
-	k_mutex_lock(&m_input_data_mutex, K_FOREVER);
-	input_a_was_active = m_input_data.input_a_is_active;
-	input_b_was_active = m_input_data.input_b_is_active;
-	k_mutex_unlock(&m_input_data_mutex);
+	input->is_active = is_active;
+	input->last_edge = now;
 
-	if (!g_app_config.cap_input_a) {
-		input_a_is_active = false;
+	if (!is_active) {
+		input->deactivations++;
+		return;
 	}
 
-	if (!g_app_config.cap_input_b) {
-		input_b_is_active = false;
-	}
+	input->activations++;
+	input->pulses++;
+
+	if (input->last_pulse) {
+		uint32_t period = (uint32_t)MIN(now - input->last_pulse, UINT32_MAX - 1);
 
-	if (g_app_config.cap_input_a) {
-		int val = gpio_pin_get_dt(&m_input_a);
-		if (val < 0) {
-			LOG_ERR_CALL_FAILED_INT("gpio_pin_get_dt", val);
-			return val;
+		if (input->period_min == UINT32_MAX || period < input->period_min) {
+			input->period_min = period;
 		}
-		input_a_is_active = !val;
-	}
 
-	if (g_app_config.cap_input_b) {
-		int val = gpio_pin_get_dt(&m_input_b);
-		if (val < 0) {
-			LOG_ERR_CALL_FAILED_INT("gpio_pin_get_dt", val);
-			return val;
+		if (input->period_max == UINT32_MAX || period > input->period_max) {
+			input->period_max = period;
 		}
-		input_b_is_active = !val;
 	}
 
-	k_mutex_lock(&m_input_data_mutex, K_FOREVER);
+	input->last_pulse = now;
+}
+
+static int sample(struct input *input)
+{
+	int ret = 0;
+
+	k_spinlock_key_t key = k_spin_lock(&m_lock);
+
+	int val = gpio_pin_get_dt(input->spec);
+	if (val < 0) {
+		ret = val;
+	} else {
+		update(input, !val, k_uptime_get());
+	}
+
+	k_spin_unlock(&m_lock, key);
+
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("gpio_pin_get_dt", ret);
+	}
+
+	return ret;
+}
+
+/* Move the edges collected so far into the input data, returns true on notification */
+static bool fold(struct input *input, bool counter, bool notify_act, bool notify_deact,
+		 bool *is_active, uint32_t *count, bool *notify_act_flag, bool *notify_deact_flag)
+{
+	k_spinlock_key_t key = k_spin_lock(&m_lock);
+
+	uint32_t activations = input->activations;
+	uint32_t deactivations = input->deactivations;
+
+	input->activations = 0;
+	input->deactivations = 0;
 
-	m_input_data.input_a_is_active = input_a_is_active;
-	m_input_data.input_b_is_active = input_b_is_active;
+	*is_active = input->is_active;
 
-	if (!input_a_was_active && input_a_is_active) {
-		if (g_app_config.input_a_counter) {
-			m_input_data.input_a_count++;
+	k_spin_unlock(&m_lock, key);
+
+	if (activations) {
+		if (counter) {
+			*count += activations;
 		}
 
-		LOG_DBG("Input A activated, count: %u", m_input_data.input_a_count);
+		LOG_DBG("Input %s activated (%u), count: %u", input->name, activations, *count);
 
-		if (g_app_config.input_a_notify_act) {
-			m_input_data.input_a_notify_act = true;
+		if (notify_act) {
+			*notify_act_flag = true;
 		}
 	}
 
-	if (input_a_was_active && !input_a_is_active) {
-		LOG_DBG("Input A deactivated");
+	if (deactivations) {
+		LOG_DBG("Input %s deactivated (%u)", input->name, deactivations);
 
-		if (g_app_config.input_a_notify_deact) {
-			m_input_data.input_a_notify_deact = true;
+		if (notify_deact) {
+			*notify_deact_flag = true;
 		}
 	}
 
-	if (!input_b_was_active && input_b_is_active) {
-		if (g_app_config.input_b_counter) {
-			m_input_data.input_b_count++;
-		}
+	return (activations && notify_act) || (deactivations && notify_deact);
+}
+
+static int poll(void)
+{
+	int ret;
 
-		LOG_DBG("Input B activated, count: %u", m_input_data.input_b_count);
+	if (g_app_config.cap_input_a && !m_a.is_counter) {
+		ret = sample(&m_a);
+		if (ret) {
+			return ret;
+		}
+	}
 
-		if (g_app_config.input_b_notify_act) {
-			m_input_data.input_b_notify_act = true;
+	if (g_app_config.cap_input_b && !m_b.is_counter) {
+		ret = sample(&m_b);
+		if (ret) {
+			return ret;
 		}
 	}
 
-	if (input_b_was_active && !input_b_is_active) {
-		LOG_DBG("Input B deactivated");
+	bool notify = false;
 
-		if (g_app_config.input_b_notify_deact) {
-			m_input_data.input_b_notify_deact = true;
-		}
+	k_mutex_lock(&m_input_data_mutex, K_FOREVER);
+
+	if (g_app_config.cap_input_a && !m_a.is_counter) {
+		notify |= fold(&m_a, g_app_config.input_a_counter, g_app_config.input_a_notify_act,
+			       g_app_config.input_a_notify_deact, &m_input_data.input_a_is_active,
+			       &m_input_data.input_a_count, &m_input_data.input_a_notify_act,
+			       &m_input_data.input_a_notify_deact);
+	}
+
+	if (g_app_config.cap_input_b && !m_b.is_counter) {
+		notify |= fold(&m_b, g_app_config.input_b_counter, g_app_config.input_b_notify_act,
+			       g_app_config.input_b_notify_deact, &m_input_data.input_b_is_active,
+			       &m_input_data.input_b_count, &m_input_data.input_b_notify_act,
+			       &m_input_data.input_b_notify_deact);
 	}
 
 	k_mutex_unlock(&m_input_data_mutex);
 
-	if (app_input_check_notify_event()) {
+	if (notify) {
 #if defined(CONFIG_LORAWAN)
 		app_lrw_send();
 #endif /* defined(CONFIG_LORAWAN) */
@@ -137,15 +240,125 @@ static void input_poll_work_handler(struct k_work *work)
 	}
 }
 
-static K_WORK_DEFINE(m_input_poll_work, input_poll_work_handler);
+static K_WORK_DELAYABLE_DEFINE(m_input_poll_work, input_poll_work_handler);
 
 static void input_timer_handler(struct k_timer *timer)
 {
-	k_work_submit(&m_input_poll_work);
+	k_work_schedule(&m_input_poll_work, K_NO_WAIT);
 }
 
 static K_TIMER_DEFINE(m_input_timer, input_timer_handler, NULL);
 
+static void input_gpio_callback(const struct device *dev, struct gpio_callback *cb, uint32_t pins)
+{
+	struct input *input = CONTAINER_OF(cb, struct input, cb);
+
+	k_spinlock_key_t key = k_spin_lock(&m_lock);
+
+	int64_t now = k_uptime_get();
+
+	/* Count the edge right away, ignore bounces within the debounce time after it */
+	if (!input->last_edge || now - input->last_edge >= g_app_config.input_debounce) {
+		int val = gpio_pin_get_dt(input->spec);
+		if (val >= 0) {
+			update(input, !val, now);
+		}
+	}
+
+	k_spin_unlock(&m_lock, key);
+
+	/* Re-read the level once the contacts settle (after the last bounce) and hand the edges
+	 * over */
+	k_work_reschedule(&m_input_poll_work, K_MSEC(g_app_config.input_debounce));
+}
+
+static int setup_interrupt(struct input *input)
+{
+	int ret;
+
+	gpio_init_callback(&input->cb, input_gpio_callback, BIT(input->spec->pin));
+
+	ret = gpio_add_callback_dt(input->spec, &input->cb);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("gpio_add_callback_dt", ret);
+		return ret;
+	}
+
+	ret = gpio_pin_interrupt_configure_dt(input->spec, GPIO_INT_EDGE_BOTH);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("gpio_pin_interrupt_configure_dt", ret);
+		return ret;
+	}
+
+	input->is_interrupt = true;
+
+	return 0;
+}
+
+#if defined(CONFIG_APP_INPUT_COUNTER)
+static int setup_counter(struct input *input)
+{
+	int ret;
+
+	if (!device_is_ready(input->counter)) {
+		LOG_ERR("Input %s counter device not ready", input->name);
+		return -ENODEV;
+	}
+
+	ret = counter_start(input->counter);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("counter_start", ret);
+		return ret;
+	}
+
+	ret = counter_get_value(input->counter, &input->counter_value);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("counter_get_value", ret);
+		return ret;
+	}
+
+	input->is_counter = true;
+
+	return 0;
+}
+
+/* Must be called with m_input_data_mutex held */
+static void read_counter(struct input *input, uint32_t *count)
+{
+	int ret;
+
+	uint32_t value;
+	ret = counter_get_value(input->counter, &value);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("counter_get_value", ret);
+		return;
+	}
+
+	uint32_t top = counter_get_top_value(input->counter);
+	uint32_t delta;
+
+	if (value >= input->counter_value) {
+		delta = value - input->counter_value;
+	} else if (input->counter_value - value <= top / 2) {
+		/* Counter never runs backwards, keep the last value instead of a bogus wrap */
+		LOG_WRN("Input %s counter went backwards: %u -> %u", input->name,
+			input->counter_value, value);
+		return;
+	} else {
+		/* Counter wrapped at its top value */
+		delta = value + (top - input->counter_value) + 1;
+	}
+
+	input->counter_value = value;
+
+	*count += delta;
+
+	k_spinlock_key_t key = k_spin_lock(&m_lock);
+	input->pulses += delta;
+	k_spin_unlock(&m_lock, key);
+}
+#endif /* defined(CONFIG_APP_INPUT_COUNTER) */
+
 int app_input_init(void)
 {
 	int ret;
@@ -172,11 +385,75 @@ int app_input_init(void)
 		return ret;
 	}
 
-	k_timer_start(&m_input_timer, K_MSEC(100), K_MSEC(100));
+#if defined(CONFIG_APP_INPUT_COUNTER)
+	if (g_app_config.cap_input_a && g_app_config.input_a_counter && m_a.counter) {
+		ret = setup_counter(&m_a);
+		if (ret) {
+			LOG_ERR_CALL_FAILED_INT("setup_counter", ret);
+			return ret;
+		}
+	}
+
+	if (g_app_config.cap_input_b && g_app_config.input_b_counter && m_b.counter) {
+		ret = setup_counter(&m_b);
+		if (ret) {
+			LOG_ERR_CALL_FAILED_INT("setup_counter", ret);
+			return ret;
+		}
+	}
+#endif /* defined(CONFIG_APP_INPUT_COUNTER) */
+
+	if (g_app_config.cap_input_a && g_app_config.input_a_interrupt && !m_a.is_counter) {
+		ret = setup_interrupt(&m_a);
+		if (ret) {
+			LOG_ERR_CALL_FAILED_INT("setup_interrupt", ret);
+			return ret;
+		}
+	}
+
+	if (g_app_config.cap_input_b && g_app_config.input_b_interrupt && !m_b.is_counter) {
+		ret = setup_interrupt(&m_b);
+		if (ret) {
+			LOG_ERR_CALL_FAILED_INT("setup_interrupt", ret);
+			return ret;
+		}
+	}
+
+	m_pulse_since = k_uptime_get();
+
+	/* Initial state of the inputs read on interrupt */
+	k_work_schedule(&m_input_poll_work, K_NO_WAIT);
+
+	/* Periodic polling only for the inputs without interrupt */
+	if ((g_app_config.cap_input_a && !m_a.is_interrupt && !m_a.is_counter) ||
+	    (g_app_config.cap_input_b && !m_b.is_interrupt && !m_b.is_counter)) {
+		k_timer_start(&m_input_timer, K_MSEC(POLL_INTERVAL_MSEC),
+			      K_MSEC(POLL_INTERVAL_MSEC));
+	}
 
 	return 0;
 }
 
+/* Must be called with m_input_data_mutex held */
+static void get_pulse_stats(struct app_input_data *data)
+{
+	k_spinlock_key_t key = k_spin_lock(&m_lock);
+
+	int64_t now = k_uptime_get();
+
+	data->input_a_pulses = m_a.pulses;
+	data->input_a_period_min = m_a.period_min;
+	data->input_a_period_max = m_a.period_max;
+
+	data->input_b_pulses = m_b.pulses;
+	data->input_b_period_min = m_b.period_min;
+	data->input_b_period_max = m_b.period_max;
+
+	data->pulse_interval = (uint32_t)((now - m_pulse_since) / 1000);
+
+	k_spin_unlock(&m_lock, key);
+}
+
 int app_input_get_data(struct app_input_data *data)
 {
 	if (!data) {
@@ -185,6 +462,7 @@ int app_input_get_data(struct app_input_data *data)
 
 	k_mutex_lock(&m_input_data_mutex, K_FOREVER);
 	*data = m_input_data;
+	get_pulse_stats(data);
 	k_mutex_unlock(&m_input_data_mutex);
 
 	return 0;
@@ -197,7 +475,19 @@ int app_input_get_data_and_clear_notify(struct app_input_data *data)
 	}
 
 	k_mutex_lock(&m_input_data_mutex, K_FOREVER);
+
+#if defined(CONFIG_APP_INPUT_COUNTER)
+	if (m_a.is_counter) {
+		read_counter(&m_a, &m_input_data.input_a_count);
+	}
+
+	if (m_b.is_counter) {
+		read_counter(&m_b, &m_input_data.input_b_count);
+	}
+#endif /* defined(CONFIG_APP_INPUT_COUNTER) */
+
 	*data = m_input_data;
+	get_pulse_stats(data);
 	m_input_data.input_a_notify_act = false;
 	m_input_data.input_a_notify_deact = false;
 	m_input_data.input_b_notify_act = false;
@@ -234,6 +524,28 @@ void app_input_clear_notify_flags(struct app_input_data *data)
 	k_mutex_unlock(&m_input_data_mutex);
 }
 
+void app_input_clear_pulse_stats(const struct app_input_data *data)
+{
+	if (!data) {
+		return;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&m_lock);
+
+	/* Keep the pulses counted since the data was taken */
+	m_a.pulses -= MIN(m_a.pulses, data->input_a_pulses);
+	m_a.period_min = UINT32_MAX;
+	m_a.period_max = UINT32_MAX;
+
+	m_b.pulses -= MIN(m_b.pulses, data->input_b_pulses);
+	m_b.period_min = UINT32_MAX;
+	m_b.period_max = UINT32_MAX;
+
+	m_pulse_since += (int64_t)data->pulse_interval * 1000;
+
+	k_spin_unlock(&m_lock, key);
+}
+
 void app_input_reset_counts(void)
 {
 	k_mutex_lock(&m_input_data_mutex, K_FOREVER);
@@ -24,12 +24,23 @@ struct app_input_data {
 	bool input_a_notify_deact;
 	bool input_b_notify_act;
 	bool input_b_notify_deact;
+	/* Pulses and min/max period (ms, UINT32_MAX if unknown) since the last clear */
+	uint32_t input_a_pulses;
+	uint32_t input_a_period_min;
+	uint32_t input_a_period_max;
+	uint32_t input_b_pulses;
+	uint32_t input_b_period_min;
+	uint32_t input_b_period_max;
+	uint32_t pulse_interval;
 };
 
 int app_input_init(void);
 int app_input_get_data(struct app_input_data *data);
+/* Hardware pulse counters (CONFIG_APP_INPUT_COUNTER) are read out only here */
 int app_input_get_data_and_clear_notify(struct app_input_data *data);
 void app_input_clear_notify_flags(struct app_input_data *data);
+/* Starts a new pulse statistics interval after the data was reported */
+void app_input_clear_pulse_stats(const struct app_input_data *data);
 bool app_input_check_notify_event(void);
 void app_input_reset_counts(void);
 
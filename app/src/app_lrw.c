@@ -11,6 +11,8 @@
 #include "app_led.h"
 #include "app_log.h"
 #include "app_lrw.h"
+#include "app_main.h"
+#include "app_queue.h"
 #include "app_sensor.h"
 
 /* Zephyr includes */
@@ -50,12 +52,24 @@ LOG_MODULE_REGISTER(app_lrw, LOG_LEVEL_DBG);
 #define REJOIN_BACKOFF_MAX_SEC   3600 /* Maximum backoff time (1 hour) */
 #define REJOIN_BACKOFF_MULTIPLIER 2   /* Exponential multiplier per attempt */
 
+/* Store-and-forward queue configuration */
+#define QUEUE_PORT                   2   /* Port of queued reports (prefixed by be32 age) */
+#define QUEUE_DRAIN_MIN_INTERVAL_SEC 10  /* Minimum interval between queued uplinks */
+#define QUEUE_AGE_SIZE               4   /* Size of the age prefix of queued uplinks */
+#define QUEUE_PRIORITY_PERIODIC      0   /* Priority of queued periodic reports */
+#define QUEUE_PRIORITY_EVENT         1   /* Priority of queued event driven reports */
+
+#define DUTY_CYCLE_EU868 100 /* Inverse of the 1 % duty cycle in EU868 */
+
 static K_THREAD_STACK_DEFINE(m_work_stack, 2048);
 static struct k_work_q m_work_q;
 static struct k_timer m_send_timer;
 static struct k_work m_send_work;
 static struct k_work m_join_work;
 
+/* Uplink requested outside the report timer (notify, alarm, early report, join) */
+static atomic_t m_is_send_requested;
+
 static atomic_t m_state = ATOMIC_INIT(APP_LRW_STATE_IDLE);
 static struct k_timer m_link_check_timer;
 static struct k_work m_link_check_work;
@@ -70,11 +84,13 @@ static int m_join_busy_polls;              /* Counter for MAC busy polling */
 static bool m_init_join;                   /* True for first join after boot */
 
 static struct k_work_delayable m_join_complete_work;
+static struct k_work_delayable m_drain_work;
 
 #define JOIN_BUSY_POLL_INTERVAL_MS  500
 #define JOIN_BUSY_MAX_POLLS         30
 
 static int m_current_dr;
+static uint8_t m_max_payload_size; /* Of the current data rate (0 until known) */
 static int16_t m_last_rssi;
 static int8_t m_last_snr;
 static uint8_t m_last_margin;
@@ -92,6 +108,14 @@ static struct k_work m_send_with_lc_work;
 static uint8_t m_lc_response_gw_count;
 
 
+static void set_state(enum app_lrw_state state)
+{
+	atomic_set(&m_state, state);
+
+	/* Update LED indication without waiting for the next blink */
+	app_main_post(APP_MAIN_EVENT_LRW_STATE);
+}
+
 static uint32_t calculate_rejoin_backoff(int attempt)
 {
 	uint32_t backoff = REJOIN_BACKOFF_BASE_SEC;
@@ -149,6 +173,7 @@ static void datarate_changed_callback(enum lorawan_datarate dr)
 
 	lorawan_get_payload_sizes(&max_next_payload_size, &max_payload_size);
 	m_current_dr = dr;
+	m_max_payload_size = max_payload_size;
 	LOG_INF("New data rate: DR%d, Maximum payload size: %d", dr, max_payload_size);
 }
 
@@ -172,7 +197,7 @@ static void join_complete_work_handler(struct k_work *work)
 		if (m_join_busy_polls >= JOIN_BUSY_MAX_POLLS) {
 			LOG_ERR("MAC busy timeout after %d ms - triggering reconnect",
 				JOIN_BUSY_MAX_POLLS * JOIN_BUSY_POLL_INTERVAL_MS);
-			atomic_set(&m_state, APP_LRW_STATE_RECONNECT);
+			set_state(APP_LRW_STATE_RECONNECT);
 			m_rejoin_attempts = 0;
 			k_timer_start(&m_link_check_timer,
 				      K_SECONDS(REJOIN_BACKOFF_BASE_SEC), K_FOREVER);
@@ -198,7 +223,7 @@ static void join_complete_work_handler(struct k_work *work)
 		uint32_t backoff = calculate_rejoin_backoff(m_rejoin_attempts);
 		LOG_ERR("Join failed (not activated), retry in %u seconds", backoff);
 		m_rejoin_attempts++;
-		atomic_set(&m_state, APP_LRW_STATE_RECONNECT);
+		set_state(APP_LRW_STATE_RECONNECT);
 		k_timer_start(&m_link_check_timer, K_SECONDS(backoff), K_FOREVER);
 		return;
 	}
@@ -207,7 +232,7 @@ static void join_complete_work_handler(struct k_work *work)
 	LOG_INF("Join successful - transitioning to HEALTHY");
 	m_init_join = false;  /* Next join will be rejoin with MAC reset */
 	lorawan_enable_adr(g_app_config.lrw_adr);
-	atomic_set(&m_state, APP_LRW_STATE_HEALTHY);
+	set_state(APP_LRW_STATE_HEALTHY);
 	m_rejoin_attempts = 0;
 	restart_normal_operation();
 }
@@ -227,7 +252,7 @@ static void handle_link_check_failure(void)
 
 		if (m_consecutive_lc_fail >= FAIL_THRESHOLD_WARNING) {
 			LOG_WRN("Entering WARNING state");
-			atomic_set(&m_state, APP_LRW_STATE_WARNING);
+			set_state(APP_LRW_STATE_WARNING);
 			m_consecutive_lc_fail = 0;
 			m_warning_lc_fail_total = 0;
 			m_force_lc_remaining = 0; /* WARNING uses normal N-th interval */
@@ -244,7 +269,7 @@ static void handle_link_check_failure(void)
 			/* Only OTAA can reconnect */
 			if (g_app_config.lrw_activation == APP_CONFIG_LRW_ACTIVATION_OTAA) {
 				LOG_ERR("Entering RECONNECT state - will rejoin in 5 seconds");
-				atomic_set(&m_state, APP_LRW_STATE_RECONNECT);
+				set_state(APP_LRW_STATE_RECONNECT);
 				m_warning_lc_fail_total = 0;
 				m_rejoin_attempts = 0; /* Reset backoff counter */
 				/* Schedule first rejoin after 5 seconds (non-blocking) */
@@ -264,6 +289,136 @@ static void handle_link_check_failure(void)
 	}
 }
 
+/* Time on air of an uplink (explicit header, CR 4/5, 13 bytes of LoRaWAN overhead) */
+static uint32_t get_time_on_air_msec(int dr, size_t len)
+{
+	int sf;
+	int bw;
+
+	dr = MAX(dr, 0);
+
+	switch (g_app_config.lrw_region) {
+	case APP_CONFIG_LRW_REGION_US915:
+		sf = dr < 4 ? 10 - dr : 8;
+		bw = dr < 4 ? 125 : 500;
+		break;
+	case APP_CONFIG_LRW_REGION_AU915:
+		sf = dr < 6 ? 12 - dr : 8;
+		bw = dr < 6 ? 125 : 500;
+		break;
+	default:
+		sf = dr < 6 ? 12 - dr : 7;
+		bw = dr < 6 ? 125 : 250;
+		break;
+	}
+
+	/* Low data rate optimization */
+	int de = sf >= 11 && bw == 125 ? 1 : 0;
+
+	int num = 8 * (int)(len + 13) - 4 * sf + 44;
+	int symbols = 8 + (num > 0 ? DIV_ROUND_UP(num, 4 * (sf - 2 * de)) * 5 : 0);
+
+	/* Symbol time in microseconds (bandwidth in kHz) */
+	uint32_t symbol_usec = (1000U << sf) / bw;
+
+	/* Preamble of 12.25 symbols */
+	return (49 + 4 * symbols) * symbol_usec / 4000;
+}
+
+uint32_t app_lrw_get_duty_cycle_msec(size_t len)
+{
+	if (g_app_config.lrw_region != APP_CONFIG_LRW_REGION_EU868) {
+		return 0;
+	}
+
+	return get_time_on_air_msec(m_current_dr, len) * DUTY_CYCLE_EU868;
+}
+
+/* Maximum application payload at the lowest data rate (AU915 with uplink dwell time) */
+static size_t get_min_payload_size(void)
+{
+	switch (g_app_config.lrw_region) {
+	case APP_CONFIG_LRW_REGION_US915:
+	case APP_CONFIG_LRW_REGION_AU915:
+		return 11;
+	default:
+		return 51;
+	}
+}
+
+size_t app_lrw_get_max_payload_size(void)
+{
+	/* Lowest data rate until the network sets one */
+	return m_max_payload_size ? m_max_payload_size : get_min_payload_size();
+}
+
+static uint32_t get_drain_interval_msec(size_t len)
+{
+	return MAX(QUEUE_DRAIN_MIN_INTERVAL_SEC * 1000, app_lrw_get_duty_cycle_msec(len));
+}
+
+static void request_send(void)
+{
+	atomic_set(&m_is_send_requested, true);
+	k_work_submit_to_queue(&m_work_q, &m_send_work);
+}
+
+static void start_drain(void)
+{
+	if (app_queue_get_count()) {
+		k_work_schedule_for_queue(&m_work_q, &m_drain_work,
+					  K_SECONDS(QUEUE_DRAIN_MIN_INTERVAL_SEC));
+	}
+}
+
+static void drain_work_handler(struct k_work *work)
+{
+	int ret;
+
+	/* Resumed by start_drain() once HEALTHY again */
+	if (atomic_get(&m_state) != APP_LRW_STATE_HEALTHY) {
+		return;
+	}
+
+	struct app_queue_entry entry;
+
+	ret = app_queue_peek(&entry);
+	if (ret) {
+		LOG_INF("Queue drained");
+		return;
+	}
+
+	uint8_t max_next_payload_size;
+	uint8_t max_payload_size;
+
+	lorawan_get_payload_sizes(&max_next_payload_size, &max_payload_size);
+
+	uint8_t buf[QUEUE_AGE_SIZE + APP_QUEUE_PAYLOAD_MAX];
+	size_t len = QUEUE_AGE_SIZE + entry.len;
+
+	/* Entries are composed to fit the lowest data rate, so wait for the data rate to rise
+	 * (or the pending MAC commands to go out) instead of dropping */
+	if (len > max_next_payload_size) {
+		LOG_WRN("Queued entry does not fit payload: %zu byte(s)", len);
+	} else {
+		sys_put_be32(entry.age, buf);
+		memcpy(&buf[QUEUE_AGE_SIZE], entry.buf, entry.len);
+
+		ret = lorawan_send(QUEUE_PORT, buf, len, LORAWAN_MSG_UNCONFIRMED);
+		if (ret) {
+			LOG_ERR_CALL_FAILED_INT("lorawan_send", ret);
+		} else {
+			LOG_INF("Sent queued entry: %u (remaining: %d)", entry.id,
+				app_queue_get_count() - 1);
+			app_queue_remove(entry.id);
+		}
+	}
+
+	/* Rate limited by the regional duty cycle */
+	k_work_schedule_for_queue(&m_work_q, &m_drain_work,
+				  K_MSEC(get_drain_interval_msec(len)));
+}
+
 static void restart_normal_operation(void)
 {
 	/* Reset all state machine counters */
@@ -275,7 +430,11 @@ static void restart_normal_operation(void)
 	m_rejoin_attempts = 0;
 
 	/* Send first message immediately after join/rejoin (with LC) */
-	k_work_submit_to_queue(&m_work_q, &m_send_work);
+	request_send();
+
+	if (atomic_get(&m_state) == APP_LRW_STATE_HEALTHY) {
+		start_drain();
+	}
 }
 
 static void handle_link_check_success(void)
@@ -299,10 +458,11 @@ static void handle_link_check_success(void)
 
 		if (m_consecutive_lc_ok >= OK_THRESHOLD_HEALTHY) {
 			LOG_INF("Returning to HEALTHY state");
-			atomic_set(&m_state, APP_LRW_STATE_HEALTHY);
+			set_state(APP_LRW_STATE_HEALTHY);
 			m_consecutive_lc_ok = 0;
 			m_warning_lc_fail_total = 0;
 			m_force_lc_remaining = 0;
+			start_drain();
 		} else {
 			/* Need more OKs, force LC on next message */
 			m_force_lc_remaining = 1;
@@ -371,9 +531,8 @@ static void join_work_handler(struct k_work *work)
 {
 	int ret;
 
-	/* Stop send timer to prevent TX during join */
-	k_timer_stop(&m_send_timer);
-	atomic_set(&m_state, APP_LRW_STATE_JOINING);
+	/* Send timer keeps running, reports are queued during join */
+	set_state(APP_LRW_STATE_JOINING);
 
 	if (m_init_join) {
 		LOG_INF("Initial join after boot");
@@ -383,7 +542,7 @@ static void join_work_handler(struct k_work *work)
 		/* ABP doesn't need rejoin - just restart normal operation */
 		if (g_app_config.lrw_activation == APP_CONFIG_LRW_ACTIVATION_ABP) {
 			LOG_INF("ABP mode - rejoin not applicable");
-			atomic_set(&m_state, APP_LRW_STATE_HEALTHY);
+			set_state(APP_LRW_STATE_HEALTHY);
 			restart_normal_operation();
 			return;
 		}
@@ -396,7 +555,7 @@ static void join_work_handler(struct k_work *work)
 			LOG_ERR("lorawan_start failed: %d", ret);
 			uint32_t backoff = calculate_rejoin_backoff(m_rejoin_attempts);
 			m_rejoin_attempts++;
-			atomic_set(&m_state, APP_LRW_STATE_RECONNECT);
+			set_state(APP_LRW_STATE_RECONNECT);
 			k_timer_start(&m_link_check_timer, K_SECONDS(backoff), K_FOREVER);
 			return;
 		}
@@ -422,7 +581,7 @@ static void join_work_handler(struct k_work *work)
 		config.abp.app_skey = g_app_config.lrw_appskey;
 	} else {
 		LOG_ERR("Invalid activation mode: %d", g_app_config.lrw_activation);
-		atomic_set(&m_state, APP_LRW_STATE_IDLE);
+		set_state(APP_LRW_STATE_IDLE);
 		return;
 	}
 
@@ -436,7 +595,7 @@ static void join_work_handler(struct k_work *work)
 		LOG_ERR("Join failed: %d, will retry in %u seconds (attempt %d)",
 			ret, backoff, m_rejoin_attempts + 1);
 		m_rejoin_attempts++;
-		atomic_set(&m_state, APP_LRW_STATE_RECONNECT);
+		set_state(APP_LRW_STATE_RECONNECT);
 		k_timer_start(&m_link_check_timer, K_SECONDS(backoff), K_FOREVER);
 		return;
 	}
@@ -485,24 +644,45 @@ static bool should_request_link_check(void)
 	return false;
 }
 
+static int queue_report(bool is_event)
+{
+	int ret;
+
+	/* Fit the lowest data rate of the region, leave room for the age prefix added when the
+	 * entry is drained */
+	uint8_t buf[APP_QUEUE_PAYLOAD_MAX - QUEUE_AGE_SIZE];
+	size_t size = MIN(get_min_payload_size() - QUEUE_AGE_SIZE, sizeof(buf));
+	size_t len;
+	ret = app_compose(buf, size, &len, true);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("app_compose", ret);
+		return ret;
+	}
+
+	ret = app_queue_push(buf, len, is_event ? QUEUE_PRIORITY_EVENT : QUEUE_PRIORITY_PERIODIC);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("app_queue_push", ret);
+		return ret;
+	}
+
+	app_compose_commit();
+
+	return 0;
+}
+
 static void send_work_handler(struct k_work *work)
 {
 	int ret;
 	bool with_link_check;
 
+	/* Requests coalesced with the timer are sent regardless of the change */
+	bool is_requested = atomic_clear(&m_is_send_requested);
+
 	/* Block normal transmissions during calibration mode */
 	if (g_app_config.calibration) {
 		return;
 	}
 
-	/* Block transmissions during joining or reconnect */
-	enum app_lrw_state state = (enum app_lrw_state)atomic_get(&m_state);
-
-	if (state == APP_LRW_STATE_JOINING || state == APP_LRW_STATE_RECONNECT) {
-		LOG_WRN("TX blocked: state=%d", (int)state);
-		return;
-	}
-
 	int timeout = g_app_config.interval_report;
 
 #if defined(CONFIG_ENTROPY_GENERATOR)
@@ -517,11 +697,26 @@ static void send_work_handler(struct k_work *work)
 		app_sensor_sample();
 	}
 
-	uint8_t buf[51];
-	size_t len;
-	ret = app_compose(buf, sizeof(buf), &len);
-	if (ret) {
-		LOG_ERR_CALL_FAILED_INT("app_compose", ret);
+	/* Periodic report with nothing moved since the last one and the heartbeat not due yet */
+	if (!is_requested && !app_sensor_is_report_due()) {
+		LOG_INF("Skipping report (no change)");
+		return;
+	}
+
+	/* Block transmissions during joining or reconnect (store the report instead) */
+	enum app_lrw_state state = (enum app_lrw_state)atomic_get(&m_state);
+
+	if (state == APP_LRW_STATE_JOINING || state == APP_LRW_STATE_RECONNECT) {
+		LOG_WRN("TX blocked: state=%d", (int)state);
+
+		/* Requested reports are event driven (alarm, notify, activity, topology) */
+		ret = queue_report(is_requested);
+		if (ret) {
+			LOG_ERR_CALL_FAILED_INT("queue_report", ret);
+			return;
+		}
+
+		app_sensor_set_reported();
 		return;
 	}
 
@@ -533,13 +728,35 @@ static void send_work_handler(struct k_work *work)
 		ret = lorawan_request_link_check(false);
 		if (ret) {
 			LOG_ERR("Link check request failed: %d", ret);
+			with_link_check = false;
 		} else {
 			m_link_check_pending = true;
 			/* Start timeout timer for response */
 			k_timer_start(&m_link_check_timer,
 				      K_SECONDS(LINK_CHECK_TIMEOUT_SEC), K_FOREVER);
-			LOG_INF("Sending data with LC (msg #%u)...", m_message_count + 1);
 		}
+	}
+
+	/* Budget the payload by the current data rate (after the pending MAC commands) */
+	uint8_t max_next_payload_size;
+	uint8_t max_payload_size;
+
+	lorawan_get_payload_sizes(&max_next_payload_size, &max_payload_size);
+
+	uint8_t buf[242];
+	size_t len;
+	ret = app_compose(buf, MIN(max_next_payload_size, sizeof(buf)), &len, false);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("app_compose", ret);
+		if (with_link_check) {
+			m_link_check_pending = false;
+			k_timer_stop(&m_link_check_timer);
+		}
+		return;
+	}
+
+	if (with_link_check) {
+		LOG_INF("Sending data with LC (msg #%u)...", m_message_count + 1);
 	} else {
 		LOG_INF("Sending data (msg #%u)...", m_message_count + 1);
 	}
@@ -557,6 +774,9 @@ static void send_work_handler(struct k_work *work)
 	/* Increment message counter after successful send */
 	m_message_count++;
 
+	app_compose_commit();
+	app_sensor_set_reported();
+
 	LOG_INF("Data sent");
 }
 
@@ -625,12 +845,13 @@ int app_lrw_init(void)
 	k_work_init(&m_lc_response_work, lc_response_work_handler);
 	k_work_init(&m_send_with_lc_work, send_with_lc_work_handler);
 	k_work_init_delayable(&m_join_complete_work, join_complete_work_handler);
+	k_work_init_delayable(&m_drain_work, drain_work_handler);
 
 	k_timer_init(&m_send_timer, send_timer_handler, NULL);
 	k_timer_init(&m_link_check_timer, link_check_timeout_handler, NULL);
 	/* Don't start send timer here - wait for join completion via DR callback */
 
-	atomic_set(&m_state, APP_LRW_STATE_IDLE);
+	set_state(APP_LRW_STATE_IDLE);
 	m_init_join = true;  /* First join after boot */
 
 	return 0;
@@ -643,7 +864,7 @@ void app_lrw_join(void)
 
 void app_lrw_send(void)
 {
-	k_work_submit_to_queue(&m_work_q, &m_send_work);
+	request_send();
 }
 
 static void send_with_lc_work_handler(struct k_work *work)
@@ -666,7 +887,7 @@ static void send_with_lc_work_handler(struct k_work *work)
 		LOG_INF("Link check requested, timeout in %d seconds", LINK_CHECK_TIMEOUT_SEC);
 	}
 
-	k_work_submit_to_queue(&m_work_q, &m_send_work);
+	request_send();
 }
 
 void app_lrw_send_with_link_check(void)
@@ -52,6 +52,12 @@ enum app_lrw_state app_lrw_get_state(void);
 int app_lrw_get_info(struct app_lrw_info *info);
 bool app_lrw_is_ready(void);
 
+/* Minimum interval between uplinks of the given length allowed by the regional duty cycle */
+uint32_t app_lrw_get_duty_cycle_msec(size_t len);
+
+/* Largest report composed at the current data rate */
+size_t app_lrw_get_max_payload_size(void);
+
 #ifdef __cplusplus
 }
 #endif
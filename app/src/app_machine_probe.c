@@ -5,6 +5,7 @@
  */
 
 #include "app_machine_probe.h"
+#include "app_config.h"
 #include "app_log.h"
 #include "app_w1.h"
 
@@ -87,21 +88,41 @@ enum sht_type {
 
 struct sensor {
 	uint64_t serial_number;
-	const struct device *dev;
+	struct w1_rom rom;
 	enum sht_type sht_type;
+	bool is_present;
 };
 
 static K_MUTEX_DEFINE(m_lock);
 
 static struct app_w1 m_w1;
 
-static struct sensor m_sensors[] = {
-	{.dev = DEVICE_DT_GET(DT_NODELABEL(machine_probe_0))},
-	{.dev = DEVICE_DT_GET(DT_NODELABEL(machine_probe_1))},
+/* Single bridge driver instance, pointed at the probe being accessed */
+static const struct device *m_sensor_dev = DEVICE_DT_GET(DT_NODELABEL(machine_probe));
+
+static struct sensor m_sensors[CONFIG_APP_MACHINE_PROBE_COUNT];
+
+/* Slot of each sensor, bound to the probe ROM in the configuration */
+static const struct app_w1_binding m_bindings[] = {
+	{.key = "config/rom-mp1", .offset = offsetof(struct app_config, rom_mp1)},
+	{.key = "config/rom-mp2", .offset = offsetof(struct app_config, rom_mp2)},
+	{.key = "config/rom-mp3", .offset = offsetof(struct app_config, rom_mp3)},
+	{.key = "config/rom-mp4", .offset = offsetof(struct app_config, rom_mp4)},
+	{.key = "config/rom-mp5", .offset = offsetof(struct app_config, rom_mp5)},
+	{.key = "config/rom-mp6", .offset = offsetof(struct app_config, rom_mp6)},
+	{.key = "config/rom-mp7", .offset = offsetof(struct app_config, rom_mp7)},
+	{.key = "config/rom-mp8", .offset = offsetof(struct app_config, rom_mp8)},
 };
 
+BUILD_ASSERT(ARRAY_SIZE(m_sensors) <= ARRAY_SIZE(m_bindings));
+
+/* Number of slots up to the last one with a probe present */
 static int m_count;
 
+/* 1-Wire time of the batch reads, for benchmarking the bridge transactions */
+static uint32_t m_bus_readings;
+static uint64_t m_bus_cycles;
+
 static int tmp112_init(const struct device *dev)
 {
 	int ret;
@@ -144,30 +165,28 @@ static int tmp112_read(const struct device *dev, float *temperature)
 {
 	int ret;
 
-	uint8_t write_buf[1];
+	static const uint8_t config_reg = 0x01;
+	static const uint8_t temperature_reg = 0x00;
+
+	uint8_t config_buf[1];
 	uint8_t read_buf[2];
 
-	write_buf[0] = 0x01;
+	const struct ds28e17_i2c_msg msgs[] = {
+		{TMP112_I2C_ADDR, &config_reg, 1, config_buf, sizeof(config_buf)},
+		{TMP112_I2C_ADDR, &temperature_reg, 1, read_buf, sizeof(read_buf)},
+	};
 
-	ret = ds28e17_i2c_write_read(dev, TMP112_I2C_ADDR, write_buf, 1, read_buf, 1);
+	ret = ds28e17_i2c_transfer(dev, msgs, ARRAY_SIZE(msgs));
 	if (ret) {
-		LOG_ERR_CALL_FAILED_INT("ds28e17_i2c_write_read", ret);
+		LOG_ERR_CALL_FAILED_INT("ds28e17_i2c_transfer", ret);
 		return ret;
 	}
 
-	if ((read_buf[0] & 0x81) != 0x81) {
+	if ((config_buf[0] & 0x81) != 0x81) {
 		LOG_ERR("Conversion not done");
 		return -EBUSY;
 	}
 
-	write_buf[0] = 0x00;
-
-	ret = ds28e17_i2c_write_read(dev, TMP112_I2C_ADDR, write_buf, 1, read_buf, 2);
-	if (ret) {
-		LOG_ERR_CALL_FAILED_INT("ds28e17_i2c_write_read", ret);
-		return ret;
-	}
-
 	if (temperature) {
 		*temperature = ((int16_t)sys_get_be16(&read_buf[0]) >> 4) * 0.0625f;
 	}
@@ -211,18 +230,8 @@ static int sht30_convert(const struct device *dev)
 	return 0;
 }
 
-static int sht30_read(const struct device *dev, float *temperature, float *humidity)
+static int sht30_parse(const uint8_t *read_buf, float *temperature, float *humidity)
 {
-	int ret;
-
-	uint8_t read_buf[6];
-
-	ret = ds28e17_i2c_read(dev, SHT30_I2C_ADDR, read_buf, 6);
-	if (ret) {
-		LOG_ERR_CALL_FAILED_INT("ds28e17_i2c_read", ret);
-		return ret;
-	}
-
 	if (sht_crc8(&read_buf[0], 2) != read_buf[2] ||
 	    sht_crc8(&read_buf[3], 2) != read_buf[5]) {
 		LOG_ERR("CRC mismatch");
@@ -240,6 +249,21 @@ static int sht30_read(const struct device *dev, float *temperature, float *humid
 	return 0;
 }
 
+static int sht30_read(const struct device *dev, float *temperature, float *humidity)
+{
+	int ret;
+
+	uint8_t read_buf[6];
+
+	ret = ds28e17_i2c_read(dev, SHT30_I2C_ADDR, read_buf, 6);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("ds28e17_i2c_read", ret);
+		return ret;
+	}
+
+	return sht30_parse(read_buf, temperature, humidity);
+}
+
 static int sht43_init(const struct device *dev)
 {
 	int ret;
@@ -276,18 +300,8 @@ static int sht43_convert(const struct device *dev)
 	return 0;
 }
 
-static int sht43_read(const struct device *dev, float *temperature, float *humidity)
+static int sht43_parse(const uint8_t *read_buf, float *temperature, float *humidity)
 {
-	int ret;
-
-	uint8_t read_buf[6];
-
-	ret = ds28e17_i2c_read(dev, SHT43_I2C_ADDR, read_buf, 6);
-	if (ret) {
-		LOG_ERR_CALL_FAILED_INT("ds28e17_i2c_read", ret);
-		return ret;
-	}
-
 	if (sht_crc8(&read_buf[0], 2) != read_buf[2] ||
 	    sht_crc8(&read_buf[3], 2) != read_buf[5]) {
 		LOG_ERR("CRC mismatch");
@@ -310,6 +324,21 @@ static int sht43_read(const struct device *dev, float *temperature, float *humid
 	return 0;
 }
 
+static int sht43_read(const struct device *dev, float *temperature, float *humidity)
+{
+	int ret;
+
+	uint8_t read_buf[6];
+
+	ret = ds28e17_i2c_read(dev, SHT43_I2C_ADDR, read_buf, 6);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("ds28e17_i2c_read", ret);
+		return ret;
+	}
+
+	return sht43_parse(read_buf, temperature, humidity);
+}
+
 static int sht_read_serial(const struct device *dev, uint32_t *serial_number,
 			   enum sht_type *detected_type)
 {
@@ -358,6 +387,33 @@ parse_serial:
 	return 0;
 }
 
+static int sht_init(const struct sensor *sensor)
+{
+	if (sensor->sht_type == SHT_TYPE_SHT43) {
+		return sht43_init(m_sensor_dev);
+	}
+
+	return sht30_init(m_sensor_dev);
+}
+
+static int sht_convert(const struct sensor *sensor)
+{
+	if (sensor->sht_type == SHT_TYPE_SHT43) {
+		return sht43_convert(m_sensor_dev);
+	}
+
+	return sht30_convert(m_sensor_dev);
+}
+
+static int sht_read(const struct sensor *sensor, float *temperature, float *humidity)
+{
+	if (sensor->sht_type == SHT_TYPE_SHT43) {
+		return sht43_read(m_sensor_dev, temperature, humidity);
+	}
+
+	return sht30_read(m_sensor_dev, temperature, humidity);
+}
+
 static int opt3001_init(const struct device *dev)
 {
 	int ret;
@@ -400,30 +456,28 @@ static int opt3001_read(const struct device *dev, float *illuminance)
 {
 	int ret;
 
-	uint8_t write_buf[1];
+	static const uint8_t config_reg = 0x01;
+	static const uint8_t result_reg = 0x00;
+
+	uint8_t config_buf[2];
 	uint8_t read_buf[2];
 
-	write_buf[0] = 0x01;
+	const struct ds28e17_i2c_msg msgs[] = {
+		{OPT3001_I2C_ADDR, &config_reg, 1, config_buf, sizeof(config_buf)},
+		{OPT3001_I2C_ADDR, &result_reg, 1, read_buf, sizeof(read_buf)},
+	};
 
-	ret = ds28e17_i2c_write_read(dev, OPT3001_I2C_ADDR, write_buf, 1, read_buf, 2);
+	ret = ds28e17_i2c_transfer(dev, msgs, ARRAY_SIZE(msgs));
 	if (ret) {
-		LOG_ERR_CALL_FAILED_INT("ds28e17_i2c_write_read", ret);
+		LOG_ERR_CALL_FAILED_INT("ds28e17_i2c_transfer", ret);
 		return ret;
 	}
 
-	if ((read_buf[0] & 0x06) != 0x00 || (read_buf[1] & 0x80) != 0x80) {
+	if ((config_buf[0] & 0x06) != 0x00 || (config_buf[1] & 0x80) != 0x80) {
 		LOG_ERR("Unexpected response");
 		return -EIO;
 	}
 
-	write_buf[0] = 0x00;
-
-	ret = ds28e17_i2c_write_read(dev, OPT3001_I2C_ADDR, write_buf, 1, read_buf, 2);
-	if (ret) {
-		LOG_ERR_CALL_FAILED_INT("ds28e17_i2c_write_read", ret);
-		return ret;
-	}
-
 	if (illuminance) {
 		uint16_t reg = sys_get_be16(&read_buf[0]);
 		*illuminance = ((1 << (reg >> 12)) * (reg & 0xfff)) * 0.01f;
@@ -497,40 +551,45 @@ static int lis2dh12_init(const struct device *dev)
 {
 	int ret;
 
-	uint8_t write_buf[2];
-
-#define LIS2DH12_WRITE_REG(reg, val)                                                               \
-	do {                                                                                       \
-		write_buf[0] = reg;                                                                \
-		write_buf[1] = val;                                                                \
-		ret = ds28e17_i2c_write(dev, LIS2DH12_I2C_ADDR, write_buf, 2);                     \
-		if (ret) {                                                                         \
-			LOG_ERR_CALL_FAILED_INT("ds28e17_i2c_write", ret);                         \
-			return ret;                                                                \
-		}                                                                                  \
-	} while (0)
-
 	/* Reboot memory content */
-	LIS2DH12_WRITE_REG(LIS2DH12_CTRL_REG5, 0x80);
+	static const uint8_t reboot[] = {LIS2DH12_CTRL_REG5, 0x80};
+
+	ret = ds28e17_i2c_write(dev, LIS2DH12_I2C_ADDR, reboot, sizeof(reboot));
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("ds28e17_i2c_write", ret);
+		return ret;
+	}
 
 	k_sleep(K_MSEC(10));
 
 	/* Enable block data update and set scale to +/-4g */
-	LIS2DH12_WRITE_REG(LIS2DH12_CTRL_REG4, 0x90);
+	static const uint8_t ctrl_reg4[] = {LIS2DH12_CTRL_REG4, 0x90};
 
 	/* High-pass filter enabled for INT1 */
-	LIS2DH12_WRITE_REG(LIS2DH12_CTRL_REG2, 0x01);
+	static const uint8_t ctrl_reg2[] = {LIS2DH12_CTRL_REG2, 0x01};
 
 	/* Enable IA1 interrupt on INT1 pin */
-	LIS2DH12_WRITE_REG(LIS2DH12_CTRL_REG3, 0x40);
+	static const uint8_t ctrl_reg3[] = {LIS2DH12_CTRL_REG3, 0x40};
 
 	/* Latch INT1 interrupt request */
-	LIS2DH12_WRITE_REG(LIS2DH12_CTRL_REG5, 0x08);
+	static const uint8_t ctrl_reg5[] = {LIS2DH12_CTRL_REG5, 0x08};
 
 	/* 10 Hz, normal mode, X/Y/Z enabled */
-	LIS2DH12_WRITE_REG(LIS2DH12_CTRL_REG1, 0x27);
+	static const uint8_t ctrl_reg1[] = {LIS2DH12_CTRL_REG1, 0x27};
+
+	const struct ds28e17_i2c_msg msgs[] = {
+		{LIS2DH12_I2C_ADDR, ctrl_reg4, sizeof(ctrl_reg4)},
+		{LIS2DH12_I2C_ADDR, ctrl_reg2, sizeof(ctrl_reg2)},
+		{LIS2DH12_I2C_ADDR, ctrl_reg3, sizeof(ctrl_reg3)},
+		{LIS2DH12_I2C_ADDR, ctrl_reg5, sizeof(ctrl_reg5)},
+		{LIS2DH12_I2C_ADDR, ctrl_reg1, sizeof(ctrl_reg1)},
+	};
 
-#undef LIS2DH12_WRITE_REG
+	ret = ds28e17_i2c_transfer(dev, msgs, ARRAY_SIZE(msgs));
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("ds28e17_i2c_transfer", ret);
+		return ret;
+	}
 
 	k_sleep(K_MSEC(50));
 
@@ -579,41 +638,25 @@ static int lis2dh12_enable_alert(const struct device *dev, int threshold, int du
 {
 	int ret;
 
-	uint8_t write_buf[2];
-	uint8_t read_buf[1];
-
-	write_buf[0] = LIS2DH12_INT1_THS;
-	write_buf[1] = threshold & BIT_MASK(7);
-
-	ret = ds28e17_i2c_write(dev, LIS2DH12_I2C_ADDR, write_buf, 2);
-	if (ret) {
-		LOG_ERR_CALL_FAILED_INT("ds28e17_i2c_write", ret);
-		return ret;
-	}
+	const uint8_t int1_ths[] = {LIS2DH12_INT1_THS, threshold & BIT_MASK(7)};
+	const uint8_t int1_duration[] = {LIS2DH12_INT1_DURATION, duration & BIT_MASK(7)};
 
-	write_buf[0] = LIS2DH12_INT1_DURATION;
-	write_buf[1] = duration & BIT_MASK(7);
+	/* Reading the reference register resets the high-pass filter */
+	static const uint8_t reference_reg = LIS2DH12_REFERENCE;
+	uint8_t reference;
 
-	ret = ds28e17_i2c_write(dev, LIS2DH12_I2C_ADDR, write_buf, 2);
-	if (ret) {
-		LOG_ERR_CALL_FAILED_INT("ds28e17_i2c_write", ret);
-		return ret;
-	}
-
-	write_buf[0] = LIS2DH12_REFERENCE;
-
-	ret = ds28e17_i2c_write_read(dev, LIS2DH12_I2C_ADDR, write_buf, 1, read_buf, 1);
-	if (ret) {
-		LOG_ERR_CALL_FAILED_INT("ds28e17_i2c_write_read", ret);
-		return ret;
-	}
+	static const uint8_t int1_cfg[] = {LIS2DH12_INT1_CFG, 0x2a};
 
-	write_buf[0] = LIS2DH12_INT1_CFG;
-	write_buf[1] = 0x2a;
+	const struct ds28e17_i2c_msg msgs[] = {
+		{LIS2DH12_I2C_ADDR, int1_ths, sizeof(int1_ths)},
+		{LIS2DH12_I2C_ADDR, int1_duration, sizeof(int1_duration)},
+		{LIS2DH12_I2C_ADDR, &reference_reg, 1, &reference, 1},
+		{LIS2DH12_I2C_ADDR, int1_cfg, sizeof(int1_cfg)},
+	};
 
-	ret = ds28e17_i2c_write(dev, LIS2DH12_I2C_ADDR, write_buf, 2);
+	ret = ds28e17_i2c_transfer(dev, msgs, ARRAY_SIZE(msgs));
 	if (ret) {
-		LOG_ERR_CALL_FAILED_INT("ds28e17_i2c_write", ret);
+		LOG_ERR_CALL_FAILED_INT("ds28e17_i2c_transfer", ret);
 		return ret;
 	}
 
@@ -658,50 +701,71 @@ static int lis2dh12_get_interrupt(const struct device *dev, bool *is_active)
 	return 0;
 }
 
-static int scan_callback(struct w1_rom rom, void *user_data)
+/* Point the bridge driver instance at the probe (no bus traffic) */
+static int select_rom(struct w1_rom rom)
 {
 	int ret;
 
-	if (rom.family != 0x19) {
-		return 0;
-	}
-
-	uint64_t serial_number = sys_get_le48(rom.serial);
-
-	if (m_count >= ARRAY_SIZE(m_sensors)) {
-		LOG_WRN("No more space for additional device: %llu", serial_number);
-		return 0;
-	}
-
-	if (!device_is_ready(m_sensors[m_count].dev)) {
+	if (!device_is_ready(m_sensor_dev)) {
 		LOG_ERR("Device not ready");
 		return -ENODEV;
 	}
 
 	struct w1_slave_config config = {.rom = rom};
-	ret = ds28e17_set_w1_config(m_sensors[m_count].dev, config);
+	ret = ds28e17_set_w1_config(m_sensor_dev, config);
 	if (ret) {
 		LOG_ERR_CALL_FAILED_INT("ds28e17_set_w1_config", ret);
 		return ret;
 	}
 
-	ret = ds28e17_write_config(m_sensors[m_count].dev, DS28E17_I2C_SPEED_100_KHZ);
+	return 0;
+}
+
+/* Other DS28E17 based devices have no accelerometer */
+static bool is_machine_probe(struct w1_rom rom)
+{
+	int ret;
+
+	if (rom.family != 0x19) {
+		return false;
+	}
+
+	ret = select_rom(rom);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("select_rom", ret);
+		return false;
+	}
+
+	ret = ds28e17_write_config(m_sensor_dev, DS28E17_I2C_SPEED_100_KHZ);
 	if (ret) {
 		LOG_ERR_CALL_FAILED_INT("ds28e17_write_config", ret);
-		return ret;
+		return false;
 	}
 
-	ret = lis2dh12_init(m_sensors[m_count].dev);
+	ret = lis2dh12_init(m_sensor_dev);
 	if (ret) {
-		LOG_DBG("Skipping serial number: %llu", serial_number);
-		return 0;
+		LOG_DBG("Skipping serial number: %llu", sys_get_le48(rom.serial));
+		return false;
 	}
 
-	m_sensors[m_count++].serial_number = serial_number;
+	return true;
+}
 
-	LOG_DBG("Registered serial number: %llu", serial_number);
+static void register_sensor(int index, struct w1_rom rom)
+{
+	struct sensor *sensor = &m_sensors[index];
+	uint64_t serial_number = sys_get_le48(rom.serial);
 
-	return 0;
+	/* Hygrometer type is detected again for a different probe */
+	if (sensor->serial_number != serial_number) {
+		sensor->sht_type = SHT_TYPE_UNKNOWN;
+	}
+
+	sensor->rom = rom;
+	sensor->serial_number = serial_number;
+	sensor->is_present = true;
+
+	LOG_DBG("Registered serial number: %llu (slot: %d)", serial_number, index);
 }
 
 int app_machine_probe_scan(void)
@@ -732,13 +796,47 @@ int app_machine_probe_scan(void)
 
 	m_count = 0;
 
-	ret = app_w1_scan(&m_w1, dev, scan_callback, NULL);
+	for (int i = 0; i < ARRAY_SIZE(m_sensors); i++) {
+		m_sensors[i].is_present = false;
+	}
+
+	struct w1_rom roms[APP_W1_SCAN_MAX];
+
+	ret = app_w1_scan(&m_w1, dev, roms, ARRAY_SIZE(roms), NULL, NULL);
 	if (ret < 0) {
 		LOG_ERR_CALL_FAILED_INT("app_w1_scan", ret);
 		res = ret;
 		goto error;
 	}
 
+	/* Machine probes only, in search order */
+	int count = 0;
+
+	for (int i = 0; i < MIN(ret, (int)ARRAY_SIZE(roms)); i++) {
+		if (is_machine_probe(roms[i])) {
+			roms[count++] = roms[i];
+		}
+	}
+
+	/* Resolved once here, the sampling path indexes the sensors by slot directly */
+	int slots[ARRAY_SIZE(m_sensors)];
+
+	ret = app_w1_bind(m_bindings, slots, ARRAY_SIZE(m_sensors), roms, count);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("app_w1_bind", ret);
+		res = ret;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(m_sensors); i++) {
+		if (slots[i] < 0) {
+			continue;
+		}
+
+		register_sensor(i, roms[slots[i]]);
+
+		m_count = i + 1;
+	}
+
 error:
 	ret = app_w1_release(&m_w1, dev);
 	if (ret) {
@@ -775,6 +873,10 @@ int app_machine_probe_get_count(void)
 		k_mutex_unlock(&m_lock);                                                           \
 		return -ERANGE;                                                                    \
 	}                                                                                          \
+	if (!m_sensors[index].is_present) {                                                        \
+		k_mutex_unlock(&m_lock);                                                           \
+		return -ENODEV;                                                                    \
+	}                                                                                          \
 	static const struct device *dev = DEVICE_DT_GET(DT_NODELABEL(ds2484));                     \
 	if (!device_is_ready(dev)) {                                                               \
 		LOG_ERR("Device not ready");                                                       \
@@ -790,12 +892,13 @@ int app_machine_probe_get_count(void)
 		res = ret;                                                                         \
 		goto error;                                                                        \
 	}                                                                                          \
-	if (!device_is_ready(m_sensors[index].dev)) {                                              \
-		LOG_ERR("Device not ready");                                                       \
-		res = -ENODEV;                                                                     \
+	ret = select_rom(m_sensors[index].rom);                                                    \
+	if (ret) {                                                                                 \
+		LOG_ERR_CALL_FAILED_INT("select_rom", ret);                                        \
+		res = ret;                                                                         \
 		goto error;                                                                        \
 	}                                                                                          \
-	ret = ds28e17_write_config(m_sensors[index].dev, DS28E17_I2C_SPEED_100_KHZ);               \
+	ret = ds28e17_write_config(m_sensor_dev, DS28E17_I2C_SPEED_100_KHZ);                       \
 	if (ret) {                                                                                 \
 		LOG_ERR_CALL_FAILED_INT("ds28e17_write_config", ret);                              \
 		res = ret;                                                                         \
@@ -825,7 +928,7 @@ int app_machine_probe_read_thermometer(int index, uint64_t *serial_number, float
 	COMM_PROLOGUE
 
 	if (!res) {
-		ret = tmp112_init(m_sensors[index].dev);
+		ret = tmp112_init(m_sensor_dev);
 		if (ret) {
 			LOG_ERR_CALL_FAILED_INT("tmp112_init", ret);
 			res = ret;
@@ -836,7 +939,7 @@ int app_machine_probe_read_thermometer(int index, uint64_t *serial_number, float
 	k_sleep(TMP112_INIT_TIME);
 
 	if (!res) {
-		ret = tmp112_convert(m_sensors[index].dev);
+		ret = tmp112_convert(m_sensor_dev);
 		if (ret) {
 			LOG_ERR_CALL_FAILED_INT("tmp112_convert", ret);
 			res = ret;
@@ -847,7 +950,7 @@ int app_machine_probe_read_thermometer(int index, uint64_t *serial_number, float
 	k_sleep(TMP112_CONV_TIME);
 
 	if (!res) {
-		ret = tmp112_read(m_sensors[index].dev, temperature);
+		ret = tmp112_read(m_sensor_dev, temperature);
 		if (ret) {
 			LOG_ERR_CALL_FAILED_INT("tmp112_read", ret);
 			res = ret;
@@ -880,8 +983,7 @@ int app_machine_probe_read_hygrometer(int index, uint64_t *serial_number, float
 	COMM_PROLOGUE
 
 	if (!res && m_sensors[index].sht_type == SHT_TYPE_UNKNOWN) {
-		ret = sht_read_serial(m_sensors[index].dev, NULL,
-				      &m_sensors[index].sht_type);
+		ret = sht_read_serial(m_sensor_dev, NULL, &m_sensors[index].sht_type);
 		if (ret) {
 			LOG_ERR_CALL_FAILED_INT("sht_read_serial", ret);
 			res = ret;
@@ -890,11 +992,7 @@ int app_machine_probe_read_hygrometer(int index, uint64_t *serial_number, float
 	}
 
 	if (!res) {
-		if (m_sensors[index].sht_type == SHT_TYPE_SHT43) {
-			ret = sht43_init(m_sensors[index].dev);
-		} else {
-			ret = sht30_init(m_sensors[index].dev);
-		}
+		ret = sht_init(&m_sensors[index]);
 		if (ret) {
 			LOG_ERR_CALL_FAILED_INT("sht_init", ret);
 			res = ret;
@@ -905,11 +1003,7 @@ int app_machine_probe_read_hygrometer(int index, uint64_t *serial_number, float
 	k_sleep(SHT30_INIT_TIME);
 
 	if (!res) {
-		if (m_sensors[index].sht_type == SHT_TYPE_SHT43) {
-			ret = sht43_convert(m_sensors[index].dev);
-		} else {
-			ret = sht30_convert(m_sensors[index].dev);
-		}
+		ret = sht_convert(&m_sensors[index]);
 		if (ret) {
 			LOG_ERR_CALL_FAILED_INT("sht_convert", ret);
 			res = ret;
@@ -920,11 +1014,7 @@ int app_machine_probe_read_hygrometer(int index, uint64_t *serial_number, float
 	k_sleep(SHT30_CONV_TIME);
 
 	if (!res) {
-		if (m_sensors[index].sht_type == SHT_TYPE_SHT43) {
-			ret = sht43_read(m_sensors[index].dev, temperature, humidity);
-		} else {
-			ret = sht30_read(m_sensors[index].dev, temperature, humidity);
-		}
+		ret = sht_read(&m_sensors[index], temperature, humidity);
 		if (ret) {
 			LOG_ERR_CALL_FAILED_INT("sht_read", ret);
 			res = ret;
@@ -957,8 +1047,7 @@ int app_machine_probe_read_hygrometer_serial(int index, uint64_t *serial_number,
 	COMM_PROLOGUE
 
 	if (!res) {
-		ret = sht_read_serial(m_sensors[index].dev, sht_serial_number,
-				      &m_sensors[index].sht_type);
+		ret = sht_read_serial(m_sensor_dev, sht_serial_number, &m_sensors[index].sht_type);
 		if (ret) {
 			LOG_ERR_CALL_FAILED_INT("sht_read_serial", ret);
 			res = ret;
@@ -986,7 +1075,7 @@ int app_machine_probe_read_lux_meter(int index, uint64_t *serial_number, float *
 	COMM_PROLOGUE
 
 	if (!res) {
-		ret = opt3001_init(m_sensors[index].dev);
+		ret = opt3001_init(m_sensor_dev);
 		if (ret) {
 			LOG_ERR_CALL_FAILED_INT("opt3001_init", ret);
 			res = ret;
@@ -997,7 +1086,7 @@ int app_machine_probe_read_lux_meter(int index, uint64_t *serial_number, float *
 	k_sleep(OPT3001_INIT_TIME);
 
 	if (!res) {
-		ret = opt3001_convert(m_sensors[index].dev);
+		ret = opt3001_convert(m_sensor_dev);
 		if (ret) {
 			LOG_ERR_CALL_FAILED_INT("opt3001_convert", ret);
 			res = ret;
@@ -1008,7 +1097,7 @@ int app_machine_probe_read_lux_meter(int index, uint64_t *serial_number, float *
 	k_sleep(OPT3001_CONV_TIME);
 
 	if (!res) {
-		ret = opt3001_read(m_sensors[index].dev, illuminance);
+		ret = opt3001_read(m_sensor_dev, illuminance);
 		if (ret) {
 			LOG_ERR_CALL_FAILED_INT("opt3001_read", ret);
 			res = ret;
@@ -1036,7 +1125,7 @@ int app_machine_probe_read_magnetometer(int index, uint64_t *serial_number, floa
 	COMM_PROLOGUE
 
 	if (!res) {
-		ret = si7210_read(m_sensors[index].dev, magnetic_field);
+		ret = si7210_read(m_sensor_dev, magnetic_field);
 		if (ret) {
 			LOG_ERR_CALL_FAILED_INT("si7210_read", ret);
 			res = ret;
@@ -1077,7 +1166,7 @@ int app_machine_probe_read_accelerometer(int index, uint64_t *serial_number, flo
 	COMM_PROLOGUE
 
 	if (!res) {
-		ret = lis2dh12_read(m_sensors[index].dev, accel_x, accel_y, accel_z);
+		ret = lis2dh12_read(m_sensor_dev, accel_x, accel_y, accel_z);
 		if (ret) {
 			LOG_ERR_CALL_FAILED_INT("lis2dh12_read", ret);
 			res = ret;
@@ -1110,7 +1199,7 @@ int app_machine_probe_enable_tilt_alert(int index, uint64_t *serial_number, int
 	COMM_PROLOGUE
 
 	if (!res) {
-		ret = lis2dh12_enable_alert(m_sensors[index].dev, threshold, duration);
+		ret = lis2dh12_enable_alert(m_sensor_dev, threshold, duration);
 		if (ret) {
 			LOG_ERR_CALL_FAILED_INT("lis2dh12_enable_alert", ret);
 			res = ret;
@@ -1130,7 +1219,7 @@ int app_machine_probe_disable_tilt_alert(int index, uint64_t *serial_number)
 	COMM_PROLOGUE
 
 	if (!res) {
-		ret = lis2dh12_disable_alert(m_sensors[index].dev);
+		ret = lis2dh12_disable_alert(m_sensor_dev);
 		if (ret) {
 			LOG_ERR_CALL_FAILED_INT("lis2dh12_disable_alert", ret);
 			res = ret;
@@ -1154,7 +1243,7 @@ int app_machine_probe_get_tilt_alert(int index, uint64_t *serial_number, bool *i
 	COMM_PROLOGUE
 
 	if (!res && is_active) {
-		ret = lis2dh12_get_interrupt(m_sensors[index].dev, is_active);
+		ret = lis2dh12_get_interrupt(m_sensor_dev, is_active);
 		if (ret) {
 			LOG_ERR_CALL_FAILED_INT("lis2dh12_get_interrupt", ret);
 			res = ret;
@@ -1168,3 +1257,230 @@ int app_machine_probe_get_tilt_alert(int index, uint64_t *serial_number, bool *i
 
 	COMM_EPILOGUE
 }
+
+/* Start the hygrometer conversion of a probe, returns 0 if it is to be read */
+static int read_all_start(struct sensor *sensor)
+{
+	int ret;
+
+	ret = select_rom(sensor->rom);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("select_rom", ret);
+		return ret;
+	}
+
+	ret = ds28e17_write_config(m_sensor_dev, DS28E17_I2C_SPEED_100_KHZ);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("ds28e17_write_config", ret);
+		return ret;
+	}
+
+	if (sensor->sht_type == SHT_TYPE_UNKNOWN) {
+		ret = sht_read_serial(m_sensor_dev, NULL, &sensor->sht_type);
+		if (ret) {
+			LOG_ERR_CALL_FAILED_INT("sht_read_serial", ret);
+			return ret;
+		}
+	}
+
+	ret = sht_init(sensor);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("sht_init", ret);
+		return ret;
+	}
+
+	return 0;
+}
+
+/* Read the hygrometer and the tilt alert of a probe in one bridge transaction */
+static int read_all_finish(const struct sensor *sensor, float *temperature, float *humidity,
+			   bool *is_tilt_alert)
+{
+	int ret;
+
+	static const uint8_t int1_src_reg = LIS2DH12_INT1_SRC;
+
+	bool is_sht43 = sensor->sht_type == SHT_TYPE_SHT43;
+	uint8_t sht_buf[6];
+	uint8_t int1_src;
+
+	const struct ds28e17_i2c_msg msgs[] = {
+		{is_sht43 ? SHT43_I2C_ADDR : SHT30_I2C_ADDR, NULL, 0, sht_buf, sizeof(sht_buf)},
+		{LIS2DH12_I2C_ADDR, &int1_src_reg, 1, &int1_src, 1},
+	};
+
+	ret = ds28e17_i2c_transfer(m_sensor_dev, msgs, ARRAY_SIZE(msgs));
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("ds28e17_i2c_transfer", ret);
+		return ret;
+	}
+
+	*is_tilt_alert = int1_src & BIT(6) ? true : false;
+
+	if (is_sht43) {
+		ret = sht43_parse(sht_buf, temperature, humidity);
+	} else {
+		ret = sht30_parse(sht_buf, temperature, humidity);
+	}
+
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("sht_parse", ret);
+		return ret;
+	}
+
+	return 0;
+}
+
+int app_machine_probe_read_all(uint64_t *serial_numbers, float *temperatures, float *humidities,
+			       bool *is_tilt_alerts, int count)
+{
+	int ret;
+	int res = 0;
+
+	if (k_is_in_isr()) {
+		return -EWOULDBLOCK;
+	}
+
+	for (int i = 0; i < count; i++) {
+		serial_numbers[i] = UINT64_MAX;
+		temperatures[i] = NAN;
+		humidities[i] = NAN;
+		is_tilt_alerts[i] = false;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	count = MIN(count, m_count);
+
+	if (count <= 0) {
+		k_mutex_unlock(&m_lock);
+		return 0;
+	}
+
+	static const struct device *dev = DEVICE_DT_GET(DT_NODELABEL(ds2484));
+
+	if (!device_is_ready(dev)) {
+		LOG_ERR("Device not ready");
+		k_mutex_unlock(&m_lock);
+		return -ENODEV;
+	}
+
+	ret = app_w1_acquire(&m_w1, dev);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("app_w1_acquire", ret);
+		k_mutex_unlock(&m_lock);
+		return ret;
+	}
+
+	/* Bit per probe taking part in the conversion */
+	uint32_t active = 0;
+
+	/* Cycles with the bus busy, the conversion waits excluded */
+	uint32_t bus_cycles = 0;
+	uint32_t start = k_cycle_get_32();
+
+	for (int i = 0; i < count; i++) {
+		if (!m_sensors[i].is_present) {
+			continue;
+		}
+
+		serial_numbers[i] = m_sensors[i].serial_number;
+
+		ret = read_all_start(&m_sensors[i]);
+		if (ret) {
+			LOG_ERR_CALL_FAILED_INT("read_all_start", ret);
+			res = res ? res : ret;
+			continue;
+		}
+
+		active |= BIT(i);
+	}
+
+	bus_cycles += k_cycle_get_32() - start;
+
+	/* Probes convert in parallel, the waits are paid once for all of them */
+	if (active) {
+		k_sleep(SHT30_INIT_TIME);
+	}
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < count; i++) {
+		if (!(active & BIT(i))) {
+			continue;
+		}
+
+		ret = select_rom(m_sensors[i].rom);
+		if (!ret) {
+			ret = sht_convert(&m_sensors[i]);
+		}
+
+		if (ret) {
+			LOG_ERR_CALL_FAILED_INT("sht_convert", ret);
+			res = res ? res : ret;
+			active &= ~BIT(i);
+		}
+	}
+
+	bus_cycles += k_cycle_get_32() - start;
+
+	if (active) {
+		k_sleep(SHT30_CONV_TIME);
+	}
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < count; i++) {
+		if (!(active & BIT(i))) {
+			continue;
+		}
+
+		ret = select_rom(m_sensors[i].rom);
+		if (ret) {
+			LOG_ERR_CALL_FAILED_INT("select_rom", ret);
+			res = res ? res : ret;
+			continue;
+		}
+
+		ret = read_all_finish(&m_sensors[i], &temperatures[i], &humidities[i],
+				      &is_tilt_alerts[i]);
+		if (ret) {
+			LOG_ERR_CALL_FAILED_INT("read_all_finish", ret);
+			res = res ? res : ret;
+			temperatures[i] = NAN;
+			humidities[i] = NAN;
+			continue;
+		}
+
+		m_bus_readings++;
+	}
+
+	bus_cycles += k_cycle_get_32() - start;
+	m_bus_cycles += bus_cycles;
+
+	LOG_DBG("Bus time: %u us", k_cyc_to_us_floor32(bus_cycles));
+
+	ret = app_w1_release(&m_w1, dev);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("app_w1_release", ret);
+		res = res ? res : ret;
+	}
+
+	k_mutex_unlock(&m_lock);
+
+	return res;
+}
+
+int app_machine_probe_get_bus_time(uint32_t *readings, uint64_t *bus_time_us)
+{
+	if (!readings || !bus_time_us) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+	*readings = m_bus_readings;
+	*bus_time_us = k_cyc_to_us_floor64(m_bus_cycles);
+	k_mutex_unlock(&m_lock);
+
+	return 0;
+}
@@ -16,6 +16,7 @@ extern "C" {
 #endif
 
 int app_machine_probe_scan(void);
+/* Sensors are indexed by the slot bound to their ROM, slots without a probe read -ENODEV */
 int app_machine_probe_get_count(void);
 int app_machine_probe_read_thermometer(int index, uint64_t *serial_number, float *temperature);
 int app_machine_probe_read_hygrometer(int index, uint64_t *serial_number, float *temperature,
@@ -31,6 +32,13 @@ int app_machine_probe_enable_tilt_alert(int index, uint64_t *serial_number, int
 int app_machine_probe_disable_tilt_alert(int index, uint64_t *serial_number);
 int app_machine_probe_get_tilt_alert(int index, uint64_t *serial_number, bool *is_active);
 
+/* Read hygrometers and tilt alerts of all probes in one bus session, failed readings are NAN */
+int app_machine_probe_read_all(uint64_t *serial_numbers, float *temperatures, float *humidities,
+			       bool *is_tilt_alerts, int count);
+
+/* Probes read by the batch reads so far and the 1-Wire time they took */
+int app_machine_probe_get_bus_time(uint32_t *readings, uint64_t *bus_time_us);
+
 #ifdef __cplusplus
 }
 #endif
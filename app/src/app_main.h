@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2025 HARDWARIO a.s.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APP_MAIN_H_
+#define APP_MAIN_H_
+
+/* Standard includes */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Events waking the main loop (in addition to the task deadlines) */
+enum app_main_event {
+	APP_MAIN_EVENT_LRW_STATE = 1 << 0,
+	APP_MAIN_EVENT_ALARM = 1 << 1,
+};
+
+void app_main_post(uint32_t events);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_MAIN_H_ */
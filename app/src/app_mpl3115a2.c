@@ -7,36 +7,43 @@
 #include "app_mpl3115a2.h"
 #include "app_log.h"
 
+#include <sticker/drivers/sensor/mpl3115a2.h>
+
 /* Zephyr includes */
 #include <zephyr/device.h>
 #include <zephyr/devicetree.h>
 #include <zephyr/drivers/sensor.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
 
 /* Standard includes */
 #include <errno.h>
+#include <stdbool.h>
 
 LOG_MODULE_REGISTER(app_mpl3115a2, LOG_LEVEL_DBG);
 
-int app_mpl3115a2_read(float *altitude, float *pressure, float *temperature)
-{
-	int ret;
+/* Channel of the conversion currently in progress (started by app_mpl3115a2_start) */
+static enum sensor_channel m_pending_chan;
 
-	const struct device *dev = DEVICE_DT_GET(DT_NODELABEL(mpl3115a2));
-	if (!device_is_ready(dev)) {
-		LOG_ERR("Device not ready");
-		return -ENODEV;
-	}
+static app_mpl3115a2_callback m_callback;
+static void *m_user_data;
 
-	ret = sensor_sample_fetch(dev);
-	if (ret) {
-		LOG_ERR_CALL_FAILED_INT("sensor_sample_fetch", ret);
-		return ret;
-	}
+static atomic_t m_is_ready;
 
-	struct sensor_value val;
+#if defined(CONFIG_MPL3115A2_TRIGGER)
+static const struct sensor_trigger m_trigger = {
+	.type = SENSOR_TRIG_DATA_READY,
+	.chan = SENSOR_CHAN_ALL,
+};
+#endif /* defined(CONFIG_MPL3115A2_TRIGGER) */
+
+static int get_values(const struct device *dev, float *altitude, float *pressure,
+		      float *temperature)
+{
+	int ret;
 
+	struct sensor_value val;
 	ret = sensor_channel_get(dev, SENSOR_CHAN_ALTITUDE, &val);
 	if (ret) {
 		LOG_ERR_CALL_FAILED_INT("sensor_channel_get", ret);
@@ -81,3 +88,123 @@ int app_mpl3115a2_read(float *altitude, float *pressure, float *temperature)
 
 	return 0;
 }
+
+#if defined(CONFIG_MPL3115A2_TRIGGER)
+static void trigger_handler(const struct device *dev, const struct sensor_trigger *trigger)
+{
+	atomic_set(&m_is_ready, 1);
+
+	if (m_callback) {
+		m_callback(m_user_data);
+	}
+}
+#endif /* defined(CONFIG_MPL3115A2_TRIGGER) */
+
+int app_mpl3115a2_read(float *altitude, float *pressure, float *temperature)
+{
+	int ret;
+
+	const struct device *dev = DEVICE_DT_GET(DT_NODELABEL(mpl3115a2));
+
+	if (!device_is_ready(dev)) {
+		LOG_ERR("Device not ready");
+		return -ENODEV;
+	}
+
+	ret = sensor_sample_fetch(dev);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("sensor_sample_fetch", ret);
+		return ret;
+	}
+
+	return get_values(dev, altitude, pressure, temperature);
+}
+
+int app_mpl3115a2_start(void)
+{
+	int ret;
+
+	const struct device *dev = DEVICE_DT_GET(DT_NODELABEL(mpl3115a2));
+
+	if (!device_is_ready(dev)) {
+		LOG_ERR("Device not ready");
+		return -ENODEV;
+	}
+
+	/* Single barometer conversion is enough if the driver derives altitude from pressure */
+	enum sensor_channel chan = IS_ENABLED(CONFIG_MPL3115A2_ALTITUDE_FROM_PRESSURE)
+					   ? SENSOR_CHAN_PRESS
+					   : SENSOR_CHAN_ALTITUDE;
+
+	atomic_clear(&m_is_ready);
+
+	ret = mpl3115a2_start(dev, chan);
+	if (ret < 0) {
+		LOG_ERR_CALL_FAILED_INT("mpl3115a2_start", ret);
+		return ret;
+	}
+
+	m_pending_chan = chan;
+
+	return ret;
+}
+
+int app_mpl3115a2_collect(float *altitude, float *pressure, float *temperature)
+{
+	int ret;
+
+	const struct device *dev = DEVICE_DT_GET(DT_NODELABEL(mpl3115a2));
+
+	ret = mpl3115a2_collect(dev, m_pending_chan);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("mpl3115a2_collect", ret);
+		return ret;
+	}
+
+	/* Altitude is done, chain barometer conversion and let the caller come back later */
+	if (m_pending_chan == SENSOR_CHAN_ALTITUDE) {
+		atomic_clear(&m_is_ready);
+
+		ret = mpl3115a2_start(dev, SENSOR_CHAN_PRESS);
+		if (ret < 0) {
+			LOG_ERR_CALL_FAILED_INT("mpl3115a2_start", ret);
+			return ret;
+		}
+
+		m_pending_chan = SENSOR_CHAN_PRESS;
+
+		return ret;
+	}
+
+	return get_values(dev, altitude, pressure, temperature);
+}
+
+bool app_mpl3115a2_is_ready(void)
+{
+	return atomic_get(&m_is_ready);
+}
+
+int app_mpl3115a2_set_callback(app_mpl3115a2_callback callback, void *user_data)
+{
+	m_callback = callback;
+	m_user_data = user_data;
+
+#if defined(CONFIG_MPL3115A2_TRIGGER)
+	int ret;
+
+	const struct device *dev = DEVICE_DT_GET(DT_NODELABEL(mpl3115a2));
+
+	if (!device_is_ready(dev)) {
+		LOG_ERR("Device not ready");
+		return -ENODEV;
+	}
+
+	ret = sensor_trigger_set(dev, &m_trigger, callback ? trigger_handler : NULL);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("sensor_trigger_set", ret);
+		return ret;
+	}
+#endif /* defined(CONFIG_MPL3115A2_TRIGGER) */
+
+	return 0;
+}
@@ -7,12 +7,27 @@
 #ifndef APP_MPL3115A2_H_
 #define APP_MPL3115A2_H_
 
+/* Standard includes */
+#include <stdbool.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+typedef void (*app_mpl3115a2_callback)(void *user_data);
+
 int app_mpl3115a2_read(float *altitude, float *pressure, float *temperature);
 
+/* Split variant of app_mpl3115a2_read: start returns milliseconds until collect may be called,
+ * collect returns 0 when done or milliseconds until it has to be called again */
+int app_mpl3115a2_start(void);
+int app_mpl3115a2_collect(float *altitude, float *pressure, float *temperature);
+bool app_mpl3115a2_is_ready(void);
+
+/* Callback is invoked (from the system work queue) when conversion started by
+ * app_mpl3115a2_start or app_mpl3115a2_collect is ready to be collected */
+int app_mpl3115a2_set_callback(app_mpl3115a2_callback callback, void *user_data);
+
 #ifdef __cplusplus
 }
 #endif
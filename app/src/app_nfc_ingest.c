@@ -167,6 +167,46 @@ bool app_nfc_ingest(const NfcConfigMessage *message)
 			}
 		}
 
+		if (message->application.has_interval_sample_adaptive) {
+			LOG_INF_PARAM_BOOL("application.interval_sample_adaptive",
+					   message->application.interval_sample_adaptive);
+			config->interval_sample_adaptive =
+				message->application.interval_sample_adaptive;
+		}
+
+		if (message->application.has_interval_sample_min) {
+			int val = message->application.interval_sample_min;
+
+			LOG_INF_PARAM_INT("application.interval_sample_min", val);
+			if (val >= 5 && val <= 3600) {
+				config->interval_sample_min = val;
+			} else {
+				LOG_WRN("Ignoring invalid interval_sample_min: %d", val);
+			}
+		}
+
+		if (message->application.has_interval_sample_delta) {
+			float val = message->application.interval_sample_delta;
+
+			LOG_INF_PARAM_FLOAT("application.interval_sample_delta", val);
+			if (val >= 0.1f && val <= 10.0f) {
+				config->interval_sample_delta = val;
+			} else {
+				LOG_WRN("Ignoring invalid interval_sample_delta");
+			}
+		}
+
+		if (message->application.has_interval_aggreg) {
+			int val = message->application.interval_aggreg;
+
+			LOG_INF_PARAM_INT("application.interval_aggreg", val);
+			if (val == 0 || (val >= 60 && val <= 86400)) {
+				config->interval_aggreg = val;
+			} else {
+				LOG_WRN("Ignoring invalid interval_aggreg: %d", val);
+			}
+		}
+
 		if (message->application.has_interval_report) {
 			int val = message->application.interval_report;
 
@@ -178,6 +218,57 @@ bool app_nfc_ingest(const NfcConfigMessage *message)
 			}
 		}
 
+		if (message->application.has_report_batch) {
+			LOG_INF_PARAM_BOOL("application.report_batch",
+					   message->application.report_batch);
+			config->report_batch = message->application.report_batch;
+		}
+
+		if (message->application.has_report_compress) {
+			LOG_INF_PARAM_BOOL("application.report_compress",
+					   message->application.report_compress);
+			config->report_compress = message->application.report_compress;
+		}
+
+		if (message->application.has_report_delta) {
+			LOG_INF_PARAM_BOOL("application.report_delta",
+					   message->application.report_delta);
+			config->report_delta = message->application.report_delta;
+		}
+
+		if (message->application.has_report_delta_temperature) {
+			float val = message->application.report_delta_temperature;
+
+			LOG_INF_PARAM_FLOAT("application.report_delta_temperature", val);
+			if (val >= 0.1f && val <= 10.0f) {
+				config->report_delta_temperature = val;
+			} else {
+				LOG_WRN("Ignoring invalid report_delta_temperature");
+			}
+		}
+
+		if (message->application.has_report_delta_humidity) {
+			float val = message->application.report_delta_humidity;
+
+			LOG_INF_PARAM_FLOAT("application.report_delta_humidity", val);
+			if (val >= 1.0f && val <= 50.0f) {
+				config->report_delta_humidity = val;
+			} else {
+				LOG_WRN("Ignoring invalid report_delta_humidity");
+			}
+		}
+
+		if (message->application.has_report_heartbeat) {
+			int val = message->application.report_heartbeat;
+
+			LOG_INF_PARAM_INT("application.report_heartbeat", val);
+			if (val >= 600 && val <= 86400) {
+				config->report_heartbeat = val;
+			} else {
+				LOG_WRN("Ignoring invalid report_heartbeat: %d", val);
+			}
+		}
+
 		if (message->application.has_alarm_temperature_enabled) {
 			LOG_INF_PARAM_BOOL("application.alarm_temperature_enabled",
 					   message->application.alarm_temperature_enabled);
@@ -378,6 +469,177 @@ bool app_nfc_ingest(const NfcConfigMessage *message)
 			}
 		}
 
+		if (message->application.has_alarm_illuminance_enabled) {
+			LOG_INF_PARAM_BOOL("application.alarm_illuminance_enabled",
+					   message->application.alarm_illuminance_enabled);
+			config->alarm_illuminance_enabled =
+				message->application.alarm_illuminance_enabled;
+		}
+
+		if (message->application.has_alarm_illuminance_lo) {
+			float val = message->application.alarm_illuminance_lo;
+
+			LOG_INF_PARAM_FLOAT("application.alarm_illuminance_lo", val);
+			if (val >= 0.0f && val <= 80000.0f) {
+				config->alarm_illuminance_lo = val;
+			} else {
+				LOG_WRN("Ignoring invalid alarm_illuminance_lo");
+			}
+		}
+
+		if (message->application.has_alarm_illuminance_hi) {
+			float val = message->application.alarm_illuminance_hi;
+
+			LOG_INF_PARAM_FLOAT("application.alarm_illuminance_hi", val);
+			if (val >= 0.0f && val <= 80000.0f) {
+				config->alarm_illuminance_hi = val;
+			} else {
+				LOG_WRN("Ignoring invalid alarm_illuminance_hi");
+			}
+		}
+
+		if (message->application.has_alarm_illuminance_hst) {
+			float val = message->application.alarm_illuminance_hst;
+
+			LOG_INF_PARAM_FLOAT("application.alarm_illuminance_hst", val);
+			if (val >= 0.0f && val <= 1000.0f) {
+				config->alarm_illuminance_hst = val;
+			} else {
+				LOG_WRN("Ignoring invalid alarm_illuminance_hst");
+			}
+		}
+
+		if (message->application.has_alarm_mp_temperature_enabled) {
+			LOG_INF_PARAM_BOOL("application.alarm_mp_temperature_enabled",
+					   message->application.alarm_mp_temperature_enabled);
+			config->alarm_mp_temperature_enabled =
+				message->application.alarm_mp_temperature_enabled;
+		}
+
+		if (message->application.has_alarm_mp_temperature_lo) {
+			float val = message->application.alarm_mp_temperature_lo;
+
+			LOG_INF_PARAM_FLOAT("application.alarm_mp_temperature_lo", val);
+			if (val >= -40.0f && val <= 125.0f) {
+				config->alarm_mp_temperature_lo = val;
+			} else {
+				LOG_WRN("Ignoring invalid alarm_mp_temperature_lo");
+			}
+		}
+
+		if (message->application.has_alarm_mp_temperature_hi) {
+			float val = message->application.alarm_mp_temperature_hi;
+
+			LOG_INF_PARAM_FLOAT("application.alarm_mp_temperature_hi", val);
+			if (val >= -40.0f && val <= 125.0f) {
+				config->alarm_mp_temperature_hi = val;
+			} else {
+				LOG_WRN("Ignoring invalid alarm_mp_temperature_hi");
+			}
+		}
+
+		if (message->application.has_alarm_mp_temperature_hst) {
+			float val = message->application.alarm_mp_temperature_hst;
+
+			LOG_INF_PARAM_FLOAT("application.alarm_mp_temperature_hst", val);
+			if (val >= 0.0f && val <= 5.0f) {
+				config->alarm_mp_temperature_hst = val;
+			} else {
+				LOG_WRN("Ignoring invalid alarm_mp_temperature_hst");
+			}
+		}
+
+		if (message->application.has_alarm_mp_humidity_enabled) {
+			LOG_INF_PARAM_BOOL("application.alarm_mp_humidity_enabled",
+					   message->application.alarm_mp_humidity_enabled);
+			config->alarm_mp_humidity_enabled =
+				message->application.alarm_mp_humidity_enabled;
+		}
+
+		if (message->application.has_alarm_mp_humidity_lo) {
+			float val = message->application.alarm_mp_humidity_lo;
+
+			LOG_INF_PARAM_FLOAT("application.alarm_mp_humidity_lo", val);
+			if (val >= 0.0f && val <= 100.0f) {
+				config->alarm_mp_humidity_lo = val;
+			} else {
+				LOG_WRN("Ignoring invalid alarm_mp_humidity_lo");
+			}
+		}
+
+		if (message->application.has_alarm_mp_humidity_hi) {
+			float val = message->application.alarm_mp_humidity_hi;
+
+			LOG_INF_PARAM_FLOAT("application.alarm_mp_humidity_hi", val);
+			if (val >= 0.0f && val <= 100.0f) {
+				config->alarm_mp_humidity_hi = val;
+			} else {
+				LOG_WRN("Ignoring invalid alarm_mp_humidity_hi");
+			}
+		}
+
+		if (message->application.has_alarm_mp_humidity_hst) {
+			float val = message->application.alarm_mp_humidity_hst;
+
+			LOG_INF_PARAM_FLOAT("application.alarm_mp_humidity_hst", val);
+			if (val >= 0.0f && val <= 20.0f) {
+				config->alarm_mp_humidity_hst = val;
+			} else {
+				LOG_WRN("Ignoring invalid alarm_mp_humidity_hst");
+			}
+		}
+
+		if (message->application.has_alarm_notify) {
+			LOG_INF_PARAM_BOOL("application.alarm_notify",
+					   message->application.alarm_notify);
+			config->alarm_notify = message->application.alarm_notify;
+		}
+
+		if (message->application.has_alarm_roc_enabled) {
+			LOG_INF_PARAM_BOOL("application.alarm_roc_enabled",
+					   message->application.alarm_roc_enabled);
+			config->alarm_roc_enabled = message->application.alarm_roc_enabled;
+		}
+
+		if (message->application.has_alarm_roc_rate) {
+			float val = message->application.alarm_roc_rate;
+
+			LOG_INF_PARAM_FLOAT("application.alarm_roc_rate", val);
+			if (val >= 0.1f && val <= 10.0f) {
+				config->alarm_roc_rate = val;
+			} else {
+				LOG_WRN("Ignoring invalid alarm_roc_rate");
+			}
+		}
+
+		if (message->application.has_alarm_roc_window) {
+			int val = message->application.alarm_roc_window;
+
+			LOG_INF_PARAM_INT("application.alarm_roc_window", val);
+			if (val >= 60 && val <= 3600) {
+				config->alarm_roc_window = val;
+			} else {
+				LOG_WRN("Ignoring invalid alarm_roc_window: %d", val);
+			}
+		}
+
+		if (message->application.has_alarm_stuck_enabled) {
+			LOG_INF_PARAM_BOOL("application.alarm_stuck_enabled",
+					   message->application.alarm_stuck_enabled);
+			config->alarm_stuck_enabled = message->application.alarm_stuck_enabled;
+		}
+
+		if (message->application.has_alarm_stuck_samples) {
+			int val = message->application.alarm_stuck_samples;
+
+			LOG_INF_PARAM_INT("application.alarm_stuck_samples", val);
+			if (val >= 3 && val <= 1000) {
+				config->alarm_stuck_samples = val;
+			} else {
+				LOG_WRN("Ignoring invalid alarm_stuck_samples: %d", val);
+			}
+		}
+
 		if (message->application.has_hall_left_counter) {
 			LOG_INF_PARAM_BOOL("application.hall_left_counter",
 					   message->application.hall_left_counter);
@@ -397,6 +659,12 @@ bool app_nfc_ingest(const NfcConfigMessage *message)
 				message->application.hall_left_notify_deact;
 		}
 
+		if (message->application.has_hall_left_interrupt) {
+			LOG_INF_PARAM_BOOL("application.hall_left_interrupt",
+					   message->application.hall_left_interrupt);
+			config->hall_left_interrupt = message->application.hall_left_interrupt;
+		}
+
 		if (message->application.has_hall_right_counter) {
 			LOG_INF_PARAM_BOOL("application.hall_right_counter",
 					   message->application.hall_right_counter);
@@ -416,6 +684,12 @@ bool app_nfc_ingest(const NfcConfigMessage *message)
 				message->application.hall_right_notify_deact;
 		}
 
+		if (message->application.has_hall_right_interrupt) {
+			LOG_INF_PARAM_BOOL("application.hall_right_interrupt",
+					   message->application.hall_right_interrupt);
+			config->hall_right_interrupt = message->application.hall_right_interrupt;
+		}
+
 		if (message->application.has_input_a_counter) {
 			LOG_INF_PARAM_BOOL("application.input_a_counter",
 					   message->application.input_a_counter);
@@ -454,6 +728,29 @@ bool app_nfc_ingest(const NfcConfigMessage *message)
 				message->application.input_b_notify_deact;
 		}
 
+		if (message->application.has_input_a_interrupt) {
+			LOG_INF_PARAM_BOOL("application.input_a_interrupt",
+					   message->application.input_a_interrupt);
+			config->input_a_interrupt = message->application.input_a_interrupt;
+		}
+
+		if (message->application.has_input_b_interrupt) {
+			LOG_INF_PARAM_BOOL("application.input_b_interrupt",
+					   message->application.input_b_interrupt);
+			config->input_b_interrupt = message->application.input_b_interrupt;
+		}
+
+		if (message->application.has_input_debounce) {
+			int val = message->application.input_debounce;
+
+			LOG_INF_PARAM_INT("application.input_debounce", val);
+			if (val >= 0 && val <= 1000) {
+				config->input_debounce = val;
+			} else {
+				LOG_WRN("Ignoring invalid input_debounce: %d", val);
+			}
+		}
+
 		if (message->application.has_corr_temperature) {
 			float val = message->application.corr_temperature;
 
@@ -487,6 +784,28 @@ bool app_nfc_ingest(const NfcConfigMessage *message)
 			}
 		}
 
+		if (message->application.has_res_t1_temperature) {
+			int val = message->application.res_t1_temperature;
+
+			LOG_INF_PARAM_INT("application.res_t1_temperature", val);
+			if (val >= 9 && val <= 12) {
+				config->res_t1_temperature = val;
+			} else {
+				LOG_WRN("Ignoring invalid res_t1_temperature: %d", val);
+			}
+		}
+
+		if (message->application.has_res_t2_temperature) {
+			int val = message->application.res_t2_temperature;
+
+			LOG_INF_PARAM_INT("application.res_t2_temperature", val);
+			if (val >= 9 && val <= 12) {
+				config->res_t2_temperature = val;
+			} else {
+				LOG_WRN("Ignoring invalid res_t2_temperature: %d", val);
+			}
+		}
+
 		if (message->application.has_cap_hall_left) {
 			LOG_INF_PARAM_BOOL("application.cap_hall_left",
 					   message->application.cap_hall_left);
@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2025 HARDWARIO a.s.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "app_queue.h"
+
+/* Zephyr includes */
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/util.h>
+
+/* Standard includes */
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(app_queue, LOG_LEVEL_DBG);
+
+#define SETTINGS_PFX "queue"
+
+/* Stored as settings value "queue/<slot>" (only the used part of the buffer) */
+struct entry {
+	/* Sequence number (0 = free slot) */
+	uint32_t seq;
+	uint32_t timestamp;
+	uint8_t priority;
+	uint8_t len;
+	uint8_t buf[APP_QUEUE_PAYLOAD_MAX];
+};
+
+static K_MUTEX_DEFINE(m_lock);
+
+static struct entry m_entries[CONFIG_APP_QUEUE_SIZE];
+static uint32_t m_seq;
+
+/* Entries loaded from flash have no valid timestamp (uptime restarted) */
+static bool m_is_loaded[CONFIG_APP_QUEUE_SIZE];
+
+static int save_entry(int slot)
+{
+	int ret;
+	char name[16];
+
+	snprintf(name, sizeof(name), SETTINGS_PFX "/%d", slot);
+
+	if (!m_entries[slot].seq) {
+		ret = settings_delete(name);
+		if (ret) {
+			LOG_ERR("Call `settings_delete` failed: %d", ret);
+			return ret;
+		}
+
+		return 0;
+	}
+
+	ret = settings_save_one(name, &m_entries[slot],
+				offsetof(struct entry, buf) + m_entries[slot].len);
+	if (ret) {
+		LOG_ERR("Call `settings_save_one` failed: %d", ret);
+		return ret;
+	}
+
+	return 0;
+}
+
+/* Highest priority first, oldest first within the same priority */
+static bool is_before(const struct entry *a, const struct entry *b)
+{
+	if (a->priority != b->priority) {
+		return a->priority > b->priority;
+	}
+
+	return a->seq < b->seq;
+}
+
+static int h_set(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg)
+{
+	int ret;
+	char *endptr;
+
+	int slot = strtol(key, &endptr, 10);
+
+	if (*endptr != '\0' || slot < 0 || slot >= ARRAY_SIZE(m_entries)) {
+		/* Slot from a build with larger queue */
+		return 0;
+	}
+
+	if (len < offsetof(struct entry, buf) || len > sizeof(m_entries[slot])) {
+		return -EINVAL;
+	}
+
+	struct entry *entry = &m_entries[slot];
+
+	ret = read_cb(cb_arg, entry, len);
+	if (ret < 0) {
+		LOG_ERR("Call `read_cb` failed: %d", ret);
+		return ret;
+	}
+
+	if (entry->len != len - offsetof(struct entry, buf)) {
+		memset(entry, 0, sizeof(*entry));
+		return -EINVAL;
+	}
+
+	m_is_loaded[slot] = true;
+	m_seq = MAX(m_seq, entry->seq);
+
+	return 0;
+}
+
+int app_queue_push(const uint8_t *buf, size_t len, int priority)
+{
+	if (len > APP_QUEUE_PAYLOAD_MAX) {
+		return -ENOSPC;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	/* Take a free slot or replace the entry which would be sent last */
+	int slot = -1;
+
+	for (int i = 0; i < ARRAY_SIZE(m_entries); i++) {
+		if (!m_entries[i].seq) {
+			slot = i;
+			break;
+		}
+
+		if (slot < 0 || is_before(&m_entries[slot], &m_entries[i])) {
+			slot = i;
+		}
+	}
+
+	if (m_entries[slot].seq) {
+		if (m_entries[slot].priority > priority) {
+			k_mutex_unlock(&m_lock);
+			LOG_WRN("Queue full of higher priority entries");
+			return -ENOSPC;
+		}
+
+		LOG_WRN("Queue full, dropping entry: %u", m_entries[slot].seq);
+	}
+
+	struct entry *entry = &m_entries[slot];
+
+	entry->seq = ++m_seq;
+	entry->timestamp = (uint32_t)(k_uptime_get() / 1000);
+	entry->priority = priority;
+	entry->len = len;
+	memcpy(entry->buf, buf, len);
+
+	m_is_loaded[slot] = false;
+
+	int ret = save_entry(slot);
+
+	k_mutex_unlock(&m_lock);
+
+	LOG_INF("Queued entry: %u (%zu byte(s), priority: %d)", entry->seq, len, priority);
+
+	return ret;
+}
+
+int app_queue_peek(struct app_queue_entry *entry)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	int slot = -1;
+
+	for (int i = 0; i < ARRAY_SIZE(m_entries); i++) {
+		if (m_entries[i].seq && (slot < 0 || is_before(&m_entries[i], &m_entries[slot]))) {
+			slot = i;
+		}
+	}
+
+	if (slot < 0) {
+		k_mutex_unlock(&m_lock);
+		return -ENOENT;
+	}
+
+	uint32_t now = (uint32_t)(k_uptime_get() / 1000);
+
+	entry->id = m_entries[slot].seq;
+	entry->age = m_is_loaded[slot] ? APP_QUEUE_AGE_UNKNOWN : now - m_entries[slot].timestamp;
+	entry->priority = m_entries[slot].priority;
+	entry->len = m_entries[slot].len;
+	memcpy(entry->buf, m_entries[slot].buf, entry->len);
+
+	k_mutex_unlock(&m_lock);
+
+	return 0;
+}
+
+int app_queue_remove(uint32_t id)
+{
+	int ret = -ENOENT;
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(m_entries); i++) {
+		if (id && m_entries[i].seq == id) {
+			memset(&m_entries[i], 0, sizeof(m_entries[i]));
+			ret = save_entry(i);
+			break;
+		}
+	}
+
+	k_mutex_unlock(&m_lock);
+
+	return ret;
+}
+
+int app_queue_get_count(void)
+{
+	int count = 0;
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(m_entries); i++) {
+		if (m_entries[i].seq) {
+			count++;
+		}
+	}
+
+	k_mutex_unlock(&m_lock);
+
+	return count;
+}
+
+static int app_queue_init(void)
+{
+	int ret;
+
+	ret = settings_subsys_init();
+	if (ret) {
+		LOG_ERR("Call `settings_subsys_init` failed: %d", ret);
+		return ret;
+	}
+
+	static struct settings_handler sh = {
+		.name = SETTINGS_PFX,
+		.h_set = h_set,
+	};
+
+	ret = settings_register(&sh);
+	if (ret) {
+		LOG_ERR("Call `settings_register` failed: %d", ret);
+		return ret;
+	}
+
+	ret = settings_load_subtree(SETTINGS_PFX);
+	if (ret) {
+		LOG_ERR("Call `settings_load_subtree` failed: %d", ret);
+		return ret;
+	}
+
+	LOG_INF("Loaded queue entries: %d", app_queue_get_count());
+
+	return 0;
+}
+
+SYS_INIT(app_queue_init, APPLICATION, 1);
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2025 HARDWARIO a.s.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APP_QUEUE_H_
+#define APP_QUEUE_H_
+
+/* Standard includes */
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Largest payload kept in the queue (maximum payload of the lowest data rate in EU868) */
+#define APP_QUEUE_PAYLOAD_MAX 51
+
+/* Age of entries stored before the last reboot */
+#define APP_QUEUE_AGE_UNKNOWN UINT32_MAX
+
+struct app_queue_entry {
+	uint32_t id;
+	/* Seconds since the entry was queued (APP_QUEUE_AGE_UNKNOWN if not known) */
+	uint32_t age;
+	int priority;
+	size_t len;
+	uint8_t buf[APP_QUEUE_PAYLOAD_MAX];
+};
+
+int app_queue_push(const uint8_t *buf, size_t len, int priority);
+int app_queue_peek(struct app_queue_entry *entry);
+int app_queue_remove(uint32_t id);
+int app_queue_get_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_QUEUE_H_ */
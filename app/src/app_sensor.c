@@ -5,19 +5,23 @@
  */
 
 #include "app_accel.h"
+#include "app_alarm.h"
 #include "app_battery.h"
 #include "app_config.h"
 #include "app_ds18b20.h"
 #include "app_hall.h"
+#include "app_history.h"
 #include "app_input.h"
 #include "app_led.h"
 #include "app_log.h"
+#include "app_lrw.h"
 #include "app_machine_probe.h"
 #include "app_mpl3115a2.h"
 #include "app_opt3001.h"
 #include "app_pyq1648.h"
 #include "app_sensor.h"
 #include "app_sht4x.h"
+#include "app_w1.h"
 
 /* Zephyr includes */
 #include <zephyr/device.h>
@@ -32,6 +36,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 LOG_MODULE_REGISTER(app_sensor, LOG_LEVEL_DBG);
 
@@ -46,16 +51,16 @@ struct app_sensor_data g_app_sensor_data = {
 	.illuminance = NAN,
 	.altitude = NAN,
 	.pressure = NAN,
-	.t1_temperature = NAN,
-	.t2_temperature = NAN,
-	.mp1_temperature = NAN,
-	.mp2_temperature = NAN,
-	.mp1_humidity = NAN,
-	.mp2_humidity = NAN,
+	.t_temperature = {[0 ... CONFIG_APP_DS18B20_COUNT - 1] = NAN},
+	.mp_temperature = {[0 ... CONFIG_APP_MACHINE_PROBE_COUNT - 1] = NAN},
+	.mp_humidity = {[0 ... CONFIG_APP_MACHINE_PROBE_COUNT - 1] = NAN},
 };
 
 K_MUTEX_DEFINE(g_app_sensor_data_lock);
 
+static K_MUTEX_DEFINE(m_sample_lock);
+static K_SEM_DEFINE(m_ready_sem, 0, 1);
+
 static K_THREAD_STACK_DEFINE(m_sensor_work_stack, 2048);
 static struct k_work_q m_sensor_work_q;
 
@@ -73,6 +78,237 @@ static void sensor_timer_handler(struct k_timer *timer)
 
 static K_TIMER_DEFINE(m_sensor_timer, sensor_timer_handler, NULL);
 
+/* Current period of the sensor timer in seconds */
+static int m_interval;
+
+/* Previous sample to detect activity, channels NAN until sampled */
+static struct app_history_sample m_prev_sample;
+
+/* Uptime from which adaptive sampling may request another report */
+static int64_t m_early_report_at;
+
+/* Readings of the last report and its uptime (send-on-delta) */
+static struct app_sensor_data m_reported;
+static uint32_t m_reported_alarms;
+static int64_t m_reported_at = -1;
+
+/* Bit per known 1-Wire probe not answering (thermometers from bit 0, machine probes from bit 16) */
+static uint32_t m_w1_missing;
+static uint32_t m_w1_missing_searched;
+
+/* Channels watched by adaptive sampling */
+static const enum app_history_channel m_adaptive_channels[] = {
+	APP_HISTORY_CHANNEL_TEMPERATURE,
+	APP_HISTORY_CHANNEL_T1_TEMPERATURE,
+	APP_HISTORY_CHANNEL_T2_TEMPERATURE,
+	APP_HISTORY_CHANNEL_MP1_TEMPERATURE,
+	APP_HISTORY_CHANNEL_MP2_TEMPERATURE,
+};
+
+struct sampler {
+	const char *name;
+	bool (*is_enabled)(void);
+	/* Start conversion, returns milliseconds until the result can be collected */
+	int (*start)(void);
+	/* Collect result, returns 0 when done or milliseconds until the next call */
+	int (*collect)(struct app_sensor_data *data);
+	/* Conversion signalled completion before its deadline */
+	bool (*is_ready)(void);
+};
+
+#if defined(CONFIG_ADC)
+static int collect_battery(struct app_sensor_data *data)
+{
+	return app_battery_measure(&data->voltage);
+}
+#endif /* defined(CONFIG_ADC) */
+
+#if defined(CONFIG_LIS2DH)
+static int collect_accel(struct app_sensor_data *data)
+{
+	return app_accel_read(NULL, NULL, NULL, &data->orientation);
+}
+#endif /* defined(CONFIG_LIS2DH) */
+
+#if defined(CONFIG_SHT4X)
+static int collect_sht4x(struct app_sensor_data *data)
+{
+	return app_sht4x_read(&data->temperature, &data->humidity);
+}
+#endif /* defined(CONFIG_SHT4X) */
+
+static bool is_light_sensor_enabled(void)
+{
+	return g_app_config.cap_light_sensor;
+}
+
+static int collect_opt3001(struct app_sensor_data *data)
+{
+	return app_opt3001_read(&data->illuminance);
+}
+
+static bool is_barometer_enabled(void)
+{
+	return g_app_config.cap_barometer;
+}
+
+static int collect_mpl3115a2(struct app_sensor_data *data)
+{
+	return app_mpl3115a2_collect(&data->altitude, &data->pressure, NULL);
+}
+
+static bool is_hall_enabled(void)
+{
+	return g_app_config.cap_hall_left || g_app_config.cap_hall_right;
+}
+
+static int collect_hall(struct app_sensor_data *data)
+{
+	int ret;
+
+	struct app_hall_data hall_data = {0};
+
+	ret = app_hall_get_data(&hall_data);
+
+	data->hall_left_count = hall_data.left_count;
+	data->hall_right_count = hall_data.right_count;
+	data->hall_left_is_active = hall_data.left_is_active;
+	data->hall_right_is_active = hall_data.right_is_active;
+
+	return ret;
+}
+
+static bool is_input_enabled(void)
+{
+	return g_app_config.cap_input_a || g_app_config.cap_input_b;
+}
+
+static int collect_input(struct app_sensor_data *data)
+{
+	int ret;
+
+	struct app_input_data input_data = {0};
+
+	ret = app_input_get_data(&input_data);
+
+	data->input_a_count = input_data.input_a_count;
+	data->input_b_count = input_data.input_b_count;
+	data->input_a_is_active = input_data.input_a_is_active;
+	data->input_b_is_active = input_data.input_b_is_active;
+
+	return ret;
+}
+
+static bool is_1w_thermometer_enabled(void)
+{
+	return g_app_config.cap_1w_thermometer;
+}
+
+static int collect_ds18b20(struct app_sensor_data *data)
+{
+	int ret;
+
+	uint64_t serial_numbers[CONFIG_APP_DS18B20_COUNT];
+	float *temperatures = data->t_temperature;
+
+	int count = MIN(app_ds18b20_get_count(), CONFIG_APP_DS18B20_COUNT);
+
+	/* Single conversion of all sensors on the bus */
+	ret = app_ds18b20_read_all(serial_numbers, temperatures, count);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("app_ds18b20_read_all", ret);
+	}
+
+	m_w1_missing &= ~BIT_MASK(16);
+
+	for (int i = 0; i < count; i++) {
+		if (isnan(temperatures[i])) {
+			m_w1_missing |= BIT(i);
+			continue;
+		}
+
+		LOG_INF("Serial number: %llu / Temperature: %.2f C", serial_numbers[i],
+			(double)temperatures[i]);
+	}
+
+	return 0;
+}
+
+static bool is_1w_machine_probe_enabled(void)
+{
+	return g_app_config.cap_1w_machine_probe;
+}
+
+static int collect_machine_probe(struct app_sensor_data *data)
+{
+	int ret;
+
+	uint64_t serial_numbers[CONFIG_APP_MACHINE_PROBE_COUNT];
+	float *temperatures = data->mp_temperature;
+	float *humidities = data->mp_humidity;
+	bool *is_tilt_alerts = data->mp_is_tilt_alert;
+
+	int count = MIN(app_machine_probe_get_count(), CONFIG_APP_MACHINE_PROBE_COUNT);
+
+	/* Single bus session with the conversions of all probes overlapping */
+	ret = app_machine_probe_read_all(serial_numbers, temperatures, humidities, is_tilt_alerts,
+					 count);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("app_machine_probe_read_all", ret);
+	}
+
+	m_w1_missing &= BIT_MASK(16);
+
+	for (int i = 0; i < count; i++) {
+		if (isnan(temperatures[i])) {
+			m_w1_missing |= BIT(16 + i);
+			continue;
+		}
+
+		LOG_INF("Serial number: %llu / Hygrometer / Temperature: "
+			"%.2f C",
+			serial_numbers[i], (double)temperatures[i]);
+		LOG_INF("Serial number: %llu / Hygrometer / Humidity: %.1f "
+			"%%",
+			serial_numbers[i], (double)humidities[i]);
+		LOG_INF("Serial number: %llu / Tilt alert is %sactive", serial_numbers[i],
+			is_tilt_alerts[i] ? "" : "not ");
+	}
+
+	return 0;
+}
+
+/* Samplers without start callback are collected right after all conversions have been started,
+ * so the blocking ones (1-Wire) run while the barometer is converting */
+static const struct sampler m_samplers[] = {
+#if defined(CONFIG_ADC)
+	{.name = "battery", .collect = collect_battery},
+#endif /* defined(CONFIG_ADC) */
+#if defined(CONFIG_LIS2DH)
+	{.name = "accel", .collect = collect_accel},
+#endif /* defined(CONFIG_LIS2DH) */
+#if defined(CONFIG_SHT4X)
+	{.name = "sht4x", .collect = collect_sht4x},
+#endif /* defined(CONFIG_SHT4X) */
+	{.name = "opt3001", .is_enabled = is_light_sensor_enabled, .collect = collect_opt3001},
+	{.name = "mpl3115a2",
+	 .is_enabled = is_barometer_enabled,
+	 .start = app_mpl3115a2_start,
+	 .collect = collect_mpl3115a2,
+	 .is_ready = app_mpl3115a2_is_ready},
+	{.name = "hall", .is_enabled = is_hall_enabled, .collect = collect_hall},
+	{.name = "input", .is_enabled = is_input_enabled, .collect = collect_input},
+	{.name = "ds18b20", .is_enabled = is_1w_thermometer_enabled, .collect = collect_ds18b20},
+	{.name = "machine_probe",
+	 .is_enabled = is_1w_machine_probe_enabled,
+	 .collect = collect_machine_probe},
+};
+
+static void mpl3115a2_ready_handler(void *user_data)
+{
+	k_sem_give(&m_ready_sem);
+}
+
 static void pyq1648_event_handler(void *user_data)
 {
 	LOG_INF("Motion detected");
@@ -86,6 +322,134 @@ static void pyq1648_event_handler(void *user_data)
 	app_led_blink(&req);
 }
 
+/* Largest temperature change since the previous sample */
+static float get_activity(const struct app_history_sample *sample)
+{
+	float activity = 0.f;
+
+	for (size_t i = 0; i < ARRAY_SIZE(m_adaptive_channels); i++) {
+		float value = sample->values[m_adaptive_channels[i]];
+		float prev = m_prev_sample.values[m_adaptive_channels[i]];
+
+		if (!isnan(value) && !isnan(prev)) {
+			activity = MAX(activity, fabsf(value - prev));
+		}
+	}
+
+	return activity;
+}
+
+/* Sample at the shortest interval on activity, back off towards interval-sample when stable */
+static void adapt_interval(const struct app_history_sample *sample)
+{
+	if (!g_app_config.interval_sample) {
+		return;
+	}
+
+	int interval = g_app_config.interval_sample;
+
+	if (g_app_config.interval_sample_adaptive) {
+		int interval_min = MIN(g_app_config.interval_sample_min, interval);
+		float activity = get_activity(sample);
+
+		if (activity >= g_app_config.interval_sample_delta) {
+			/* Report the activity without waiting for the report timer */
+			if (m_interval > interval_min && k_uptime_get() >= m_early_report_at) {
+				LOG_INF("Activity detected (change: %.2f)", (double)activity);
+				m_early_report_at = k_uptime_get() + interval * 1000LL;
+#if defined(CONFIG_LORAWAN)
+				app_lrw_send();
+#endif /* defined(CONFIG_LORAWAN) */
+			}
+
+			interval = interval_min;
+		} else {
+			interval = MIN(m_interval * 2, interval);
+		}
+	}
+
+	m_prev_sample = *sample;
+
+	if (interval != m_interval) {
+		LOG_INF("Sample interval: %d s", interval);
+		m_interval = interval;
+		k_timer_start(&m_sensor_timer, K_SECONDS(interval), K_SECONDS(interval));
+	}
+}
+
+static int scan_w1(void)
+{
+	int ret;
+	int res = 0;
+
+	if (g_app_config.cap_1w_thermometer) {
+		ret = app_ds18b20_scan();
+		if (ret) {
+			LOG_ERR_CALL_FAILED_INT("app_ds18b20_scan", ret);
+			res = res ? res : ret;
+		}
+	}
+
+	if (g_app_config.cap_1w_machine_probe) {
+		ret = app_machine_probe_scan();
+		if (ret) {
+			LOG_ERR_CALL_FAILED_INT("app_machine_probe_scan", ret);
+			res = res ? res : ret;
+		}
+
+		int count = app_machine_probe_get_count();
+
+		for (int i = 0; i < count; i++) {
+			uint64_t serial_number;
+			ret = app_machine_probe_enable_tilt_alert(i, &serial_number, TILT_THRESHOLD,
+								  TILT_DURATION);
+
+			/* Slot without its probe */
+			if (ret == -ENODEV) {
+				continue;
+			}
+
+			if (ret) {
+				LOG_ERR_CALL_FAILED_INT("app_machine_probe_enable_tilt_alert", ret);
+				res = res ? res : ret;
+			}
+		}
+	}
+
+	return res;
+}
+
+/* Search the bus again when the set of answering probes changed or the presence pulse suggests so
+ * (a probe failing persistently is searched for only once) */
+static void check_w1(void)
+{
+	int ret;
+
+	if (!g_app_config.cap_1w_thermometer && !g_app_config.cap_1w_machine_probe) {
+		return;
+	}
+
+	if (m_w1_missing == m_w1_missing_searched && !app_w1_is_search_due()) {
+		return;
+	}
+
+	m_w1_missing_searched = m_w1_missing;
+
+	bool was_changed = app_w1_is_topology_changed(false);
+
+	ret = scan_w1();
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("scan_w1", ret);
+	}
+
+	/* Report the new topology right away */
+	if (!was_changed && app_w1_is_topology_changed(false)) {
+#if defined(CONFIG_LORAWAN)
+		app_lrw_send();
+#endif /* defined(CONFIG_LORAWAN) */
+	}
+}
+
 int app_sensor_init(void)
 {
 	int ret;
@@ -108,6 +472,12 @@ int app_sensor_init(void)
 		if (ret) {
 			LOG_ERR_CALL_FAILED_CTX_INT("device_init", "mpl3115a2", ret);
 			res = res ? res : ret;
+		} else {
+			ret = app_mpl3115a2_set_callback(mpl3115a2_ready_handler, NULL);
+			if (ret) {
+				LOG_ERR_CALL_FAILED_INT("app_mpl3115a2_set_callback", ret);
+				res = res ? res : ret;
+			}
 		}
 	}
 
@@ -151,63 +521,29 @@ int app_sensor_init(void)
 	}
 
 	if (g_app_config.cap_1w_thermometer) {
-		const struct device *dev_0 = DEVICE_DT_GET(DT_NODELABEL(ds18b20_0));
-
-		ret = device_init(dev_0);
-		if (ret) {
-			LOG_ERR_CALL_FAILED_CTX_INT("device_init", "ds18b20_0", ret);
-			res = res ? res : ret;
-		}
+		const struct device *dev = DEVICE_DT_GET(DT_NODELABEL(ds18b20));
 
-		const struct device *dev_1 = DEVICE_DT_GET(DT_NODELABEL(ds18b20_1));
-
-		ret = device_init(dev_1);
-		if (ret) {
-			LOG_ERR_CALL_FAILED_CTX_INT("device_init", "ds18b20_1", ret);
-			res = res ? res : ret;
-		}
-
-		ret = app_ds18b20_scan();
+		ret = device_init(dev);
 		if (ret) {
-			LOG_ERR_CALL_FAILED_INT("app_ds18b20_scan", ret);
+			LOG_ERR_CALL_FAILED_CTX_INT("device_init", "ds18b20", ret);
 			res = res ? res : ret;
 		}
 	}
 
 	if (g_app_config.cap_1w_machine_probe) {
-		const struct device *dev_0 = DEVICE_DT_GET(DT_NODELABEL(machine_probe_0));
+		const struct device *dev = DEVICE_DT_GET(DT_NODELABEL(machine_probe));
 
-		ret = device_init(dev_0);
-		if (ret) {
-			LOG_ERR_CALL_FAILED_CTX_INT("device_init", "machine_probe_0", ret);
-			res = res ? res : ret;
-		}
-
-		const struct device *dev_1 = DEVICE_DT_GET(DT_NODELABEL(machine_probe_1));
-
-		ret = device_init(dev_1);
-		if (ret) {
-			LOG_ERR_CALL_FAILED_CTX_INT("device_init", "machine_probe_1", ret);
-			res = res ? res : ret;
-		}
-
-		ret = app_machine_probe_scan();
+		ret = device_init(dev);
 		if (ret) {
-			LOG_ERR_CALL_FAILED_INT("app_machine_probe_scan", ret);
+			LOG_ERR_CALL_FAILED_CTX_INT("device_init", "machine_probe", ret);
 			res = res ? res : ret;
 		}
+	}
 
-		int count = app_machine_probe_get_count();
-
-		for (int i = 0; i < count; i++) {
-			uint64_t serial_number;
-			ret = app_machine_probe_enable_tilt_alert(i, &serial_number, TILT_THRESHOLD,
-								  TILT_DURATION);
-			if (ret) {
-				LOG_ERR_CALL_FAILED_INT("app_machine_probe_enable_tilt_alert", ret);
-				res = res ? res : ret;
-			}
-		}
+	ret = scan_w1();
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("scan_w1", ret);
+		res = res ? res : ret;
 	}
 
 	k_work_queue_init(&m_sensor_work_q);
@@ -216,189 +552,236 @@ int app_sensor_init(void)
 			   K_THREAD_STACK_SIZEOF(m_sensor_work_stack),
 			   K_LOWEST_APPLICATION_THREAD_PRIO, NULL);
 
+	for (size_t i = 0; i < ARRAY_SIZE(m_prev_sample.values); i++) {
+		m_prev_sample.values[i] = NAN;
+	}
+
 	if (!res && g_app_config.interval_sample) {
-		k_timer_start(&m_sensor_timer, K_SECONDS(1),
-			      K_SECONDS(g_app_config.interval_sample));
+		m_interval = g_app_config.interval_sample;
+		k_timer_start(&m_sensor_timer, K_SECONDS(1), K_SECONDS(m_interval));
 	}
 
 	return res;
 }
 
-void app_sensor_sample(void)
+static bool is_moved(float value, float reported, float delta)
 {
-	int ret;
-
-	int orientation = INT_MAX;
-	float voltage = NAN;
-
-	float temperature = NAN;
-	float humidity = NAN;
-	float illuminance = NAN;
-	float altitude = NAN;
-	float pressure = NAN;
+	if (isnan(value) || isnan(reported)) {
+		return isnan(value) != isnan(reported);
+	}
 
-	struct app_hall_data hall_data = {0};
-	struct app_input_data input_data = {0};
+	return fabsf(value - reported) >= delta;
+}
 
-	float t1_temperature = NAN;
-	float t2_temperature = NAN;
+/* Any reading moved by its delta or a state changed since the last report */
+static bool is_moved_since_report(void)
+{
+	float dt = g_app_config.report_delta_temperature;
+	float dh = g_app_config.report_delta_humidity;
 
-	float mp1_temperature = NAN;
-	float mp2_temperature = NAN;
-	float mp1_humidity = NAN;
-	float mp2_humidity = NAN;
-	bool mp1_is_tilt_alert = false;
-	bool mp2_is_tilt_alert = false;
+	k_mutex_lock(&g_app_sensor_data_lock, K_FOREVER);
 
-#if defined(CONFIG_ADC)
-	ret = app_battery_measure(&voltage);
-	if (ret) {
-		LOG_ERR_CALL_FAILED_INT("app_battery_measure", ret);
+	const struct app_sensor_data *d = &g_app_sensor_data;
+	const struct app_sensor_data *r = &m_reported;
+
+	/* Counters are left for the heartbeat, state changes are reported */
+	bool moved = app_alarm_get_state() != m_reported_alarms ||
+		     is_moved(d->temperature, r->temperature, dt) ||
+		     is_moved(d->humidity, r->humidity, dh) ||
+		     d->orientation != r->orientation ||
+		     d->hall_left_is_active != r->hall_left_is_active ||
+		     d->hall_right_is_active != r->hall_right_is_active ||
+		     d->input_a_is_active != r->input_a_is_active ||
+		     d->input_b_is_active != r->input_b_is_active;
+
+	for (int i = 0; i < CONFIG_APP_DS18B20_COUNT; i++) {
+		moved = moved || is_moved(d->t_temperature[i], r->t_temperature[i], dt);
 	}
-#endif /* defined(CONFIG_ADC) */
 
-#if defined(CONFIG_LIS2DH)
-	ret = app_accel_read(NULL, NULL, NULL, &orientation);
-	if (ret) {
-		LOG_ERR_CALL_FAILED_INT("app_accel_read", ret);
+	for (int i = 0; i < CONFIG_APP_MACHINE_PROBE_COUNT; i++) {
+		moved = moved || is_moved(d->mp_temperature[i], r->mp_temperature[i], dt) ||
+			is_moved(d->mp_humidity[i], r->mp_humidity[i], dh) ||
+			d->mp_is_tilt_alert[i] != r->mp_is_tilt_alert[i];
 	}
-#endif /* defined(CONFIG_LIS2DH) */
 
-#if defined(CONFIG_SHT4X)
-	ret = app_sht4x_read(&temperature, &humidity);
-	if (ret) {
-		LOG_ERR_CALL_FAILED_INT("app_sht4x_read", ret);
-	}
-#endif /* defined(CONFIG_SHT4X) */
+	k_mutex_unlock(&g_app_sensor_data_lock);
 
-	if (g_app_config.cap_light_sensor) {
-		ret = app_opt3001_read(&illuminance);
-		if (ret) {
-			LOG_ERR_CALL_FAILED_INT("app_opt3001_read", ret);
-		}
-	}
+	return moved;
+}
 
-	if (g_app_config.cap_barometer) {
-		ret = app_mpl3115a2_read(&altitude, &pressure, NULL);
-		if (ret) {
-			LOG_ERR_CALL_FAILED_INT("app_mpl3115a2_read", ret);
-		}
-	}
+void app_sensor_sample(void)
+{
+	int ret;
 
-	if (g_app_config.cap_hall_left || g_app_config.cap_hall_right) {
-		ret = app_hall_get_data(&hall_data);
-		if (ret) {
-			LOG_ERR_CALL_FAILED_INT("app_hall_get_data", ret);
-		}
-	}
+	struct app_sensor_data data = {
+		.orientation = INT_MAX,
+		.voltage = NAN,
+		.temperature = NAN,
+		.humidity = NAN,
+		.illuminance = NAN,
+		.altitude = NAN,
+		.pressure = NAN,
+		.t_temperature = {[0 ... CONFIG_APP_DS18B20_COUNT - 1] = NAN},
+		.mp_temperature = {[0 ... CONFIG_APP_MACHINE_PROBE_COUNT - 1] = NAN},
+		.mp_humidity = {[0 ... CONFIG_APP_MACHINE_PROBE_COUNT - 1] = NAN},
+	};
 
-	if (g_app_config.cap_input_a || g_app_config.cap_input_b) {
-		ret = app_input_get_data(&input_data);
-		if (ret) {
-			LOG_ERR_CALL_FAILED_INT("app_input_get_data", ret);
-		}
-	}
+	/* Deadline of every pending sampler, -1 if not pending */
+	int64_t deadlines[ARRAY_SIZE(m_samplers)];
 
-	if (g_app_config.cap_1w_thermometer) {
-		int count = app_ds18b20_get_count();
+	k_mutex_lock(&m_sample_lock, K_FOREVER);
 
-		for (int i = 0; i < count; i++) {
-			uint64_t serial_number;
-			float temperature;
-			ret = app_ds18b20_read(i, &serial_number, &temperature);
-			if (ret) {
-				LOG_ERR_CALL_FAILED_INT("app_ds18b20_read", ret);
-				continue;
-			}
+	k_sem_reset(&m_ready_sem);
 
-			LOG_INF("Serial number: %llu / Temperature: %.2f C", serial_number,
-				(double)temperature);
+	/* Start all conversions first */
+	for (size_t i = 0; i < ARRAY_SIZE(m_samplers); i++) {
+		const struct sampler *sampler = &m_samplers[i];
 
-			if (i == 0) {
-				t1_temperature = temperature;
-			} else if (i == 1) {
-				t2_temperature = temperature;
-			}
+		deadlines[i] = -1;
+
+		if (sampler->is_enabled && !sampler->is_enabled()) {
+			continue;
+		}
+
+		ret = sampler->start ? sampler->start() : 0;
+		if (ret < 0) {
+			LOG_ERR("Call `start` failed (%s): %d", sampler->name, ret);
+			continue;
 		}
+
+		deadlines[i] = k_uptime_get() + ret;
 	}
 
-	if (g_app_config.cap_1w_machine_probe) {
-		int count = app_machine_probe_get_count();
+	/* Collect results in deadline order */
+	for (;;) {
+		int next = -1;
+		int64_t next_due = 0;
 
-		for (int i = 0; i < count; i++) {
-			uint64_t serial_number;
-			float hygrometer_temperature;
-			float hygrometer_humidity;
-			bool is_tilt_alert;
-			ret = app_machine_probe_read_hygrometer(
-				i, &serial_number, &hygrometer_temperature, &hygrometer_humidity);
-			if (ret) {
-				LOG_ERR_CALL_FAILED_INT("app_machine_probe_read_hygrometer", ret);
+		for (size_t i = 0; i < ARRAY_SIZE(m_samplers); i++) {
+			if (deadlines[i] < 0) {
 				continue;
 			}
 
-			LOG_INF("Serial number: %llu / Hygrometer / Temperature: "
-				"%.2f C",
-				serial_number, (double)hygrometer_temperature);
-			LOG_INF("Serial number: %llu / Hygrometer / Humidity: %.1f "
-				"%%",
-				serial_number, (double)hygrometer_humidity);
-
-			if (i == 0) {
-				mp1_temperature = hygrometer_temperature;
-				mp1_humidity = hygrometer_humidity;
-			} else if (i == 1) {
-				mp2_temperature = hygrometer_temperature;
-				mp2_humidity = hygrometer_humidity;
-			}
+			/* Conversion which already signalled completion is due right now */
+			bool is_ready = m_samplers[i].is_ready && m_samplers[i].is_ready();
+			int64_t due = is_ready ? 0 : deadlines[i];
 
-			ret = app_machine_probe_get_tilt_alert(i, &serial_number, &is_tilt_alert);
-			if (ret) {
-				LOG_ERR_CALL_FAILED_INT("app_machine_probe_get_tilt_alert", ret);
-				continue;
+			if (next < 0 || due < next_due) {
+				next = i;
+				next_due = due;
 			}
+		}
+
+		if (next < 0) {
+			break;
+		}
 
-			LOG_INF("Serial number: %llu / Tilt alert is %sactive", serial_number,
-				is_tilt_alert ? "" : "not ");
+		int64_t delta = next_due - k_uptime_get();
+		if (delta > 0) {
+			/* Wake up on deadline or once any conversion signals completion */
+			k_sem_take(&m_ready_sem, K_MSEC(delta));
+			continue;
+		}
 
-			if (i == 0) {
-				mp1_is_tilt_alert = is_tilt_alert;
-			} else if (i == 1) {
-				mp2_is_tilt_alert = is_tilt_alert;
-			}
+		ret = m_samplers[next].collect(&data);
+		if (ret > 0) {
+			deadlines[next] = k_uptime_get() + ret;
+			continue;
+		}
+
+		if (ret < 0) {
+			LOG_ERR("Call `collect` failed (%s): %d", m_samplers[next].name, ret);
 		}
+
+		deadlines[next] = -1;
 	}
 
 	k_mutex_lock(&g_app_sensor_data_lock, K_FOREVER);
 
-	g_app_sensor_data.orientation = orientation;
-	g_app_sensor_data.voltage = voltage;
+	g_app_sensor_data.orientation = data.orientation;
+	g_app_sensor_data.voltage = data.voltage;
+
+	g_app_sensor_data.temperature = data.temperature + g_app_config.corr_temperature;
+	g_app_sensor_data.humidity = data.humidity;
+	g_app_sensor_data.illuminance = data.illuminance;
+	g_app_sensor_data.altitude = data.altitude;
+	g_app_sensor_data.pressure = data.pressure;
+
+	g_app_sensor_data.hall_left_count = data.hall_left_count;
+	g_app_sensor_data.hall_right_count = data.hall_right_count;
+	g_app_sensor_data.hall_left_is_active = data.hall_left_is_active;
+	g_app_sensor_data.hall_right_is_active = data.hall_right_is_active;
+
+	g_app_sensor_data.input_a_count = data.input_a_count;
+	g_app_sensor_data.input_b_count = data.input_b_count;
+	g_app_sensor_data.input_a_is_active = data.input_a_is_active;
+	g_app_sensor_data.input_b_is_active = data.input_b_is_active;
+
+	/* Slots beyond T2 have no correction parameter */
+	data.t_temperature[0] += g_app_config.corr_t1_temperature;
+	data.t_temperature[1] += g_app_config.corr_t2_temperature;
+
+	memcpy(g_app_sensor_data.t_temperature, data.t_temperature, sizeof(data.t_temperature));
+	memcpy(g_app_sensor_data.mp_temperature, data.mp_temperature, sizeof(data.mp_temperature));
+	memcpy(g_app_sensor_data.mp_humidity, data.mp_humidity, sizeof(data.mp_humidity));
+	memcpy(g_app_sensor_data.mp_is_tilt_alert, data.mp_is_tilt_alert,
+	       sizeof(data.mp_is_tilt_alert));
+
+	struct app_history_sample sample = {
+		.timestamp = (uint32_t)(k_uptime_get() / 1000),
+		.values = {
+			[APP_HISTORY_CHANNEL_VOLTAGE] = g_app_sensor_data.voltage,
+			[APP_HISTORY_CHANNEL_TEMPERATURE] = g_app_sensor_data.temperature,
+			[APP_HISTORY_CHANNEL_HUMIDITY] = g_app_sensor_data.humidity,
+			[APP_HISTORY_CHANNEL_ILLUMINANCE] = g_app_sensor_data.illuminance,
+			[APP_HISTORY_CHANNEL_T1_TEMPERATURE] = g_app_sensor_data.t_temperature[0],
+			[APP_HISTORY_CHANNEL_T2_TEMPERATURE] = g_app_sensor_data.t_temperature[1],
+			[APP_HISTORY_CHANNEL_ALTITUDE] = g_app_sensor_data.altitude,
+			[APP_HISTORY_CHANNEL_PRESSURE] = g_app_sensor_data.pressure,
+			[APP_HISTORY_CHANNEL_MP1_TEMPERATURE] = g_app_sensor_data.mp_temperature[0],
+			[APP_HISTORY_CHANNEL_MP2_TEMPERATURE] = g_app_sensor_data.mp_temperature[1],
+			[APP_HISTORY_CHANNEL_MP1_HUMIDITY] = g_app_sensor_data.mp_humidity[0],
+			[APP_HISTORY_CHANNEL_MP2_HUMIDITY] = g_app_sensor_data.mp_humidity[1],
+		},
+	};
+
+	k_mutex_unlock(&g_app_sensor_data_lock);
 
-	g_app_sensor_data.temperature = temperature + g_app_config.corr_temperature;
-	g_app_sensor_data.humidity = humidity;
-	g_app_sensor_data.illuminance = illuminance;
-	g_app_sensor_data.altitude = altitude;
-	g_app_sensor_data.pressure = pressure;
+	app_history_push(&sample);
 
-	g_app_sensor_data.hall_left_count = hall_data.left_count;
-	g_app_sensor_data.hall_right_count = hall_data.right_count;
-	g_app_sensor_data.hall_left_is_active = hall_data.left_is_active;
-	g_app_sensor_data.hall_right_is_active = hall_data.right_is_active;
+	app_alarm_evaluate(&sample);
 
-	g_app_sensor_data.input_a_count = input_data.input_a_count;
-	g_app_sensor_data.input_b_count = input_data.input_b_count;
-	g_app_sensor_data.input_a_is_active = input_data.input_a_is_active;
-	g_app_sensor_data.input_b_is_active = input_data.input_b_is_active;
+	adapt_interval(&sample);
 
-	g_app_sensor_data.t1_temperature = t1_temperature + g_app_config.corr_t1_temperature;
-	g_app_sensor_data.t2_temperature = t2_temperature + g_app_config.corr_t2_temperature;
+	check_w1();
 
-	g_app_sensor_data.mp1_temperature = mp1_temperature;
-	g_app_sensor_data.mp2_temperature = mp2_temperature;
-	g_app_sensor_data.mp1_humidity = mp1_humidity;
-	g_app_sensor_data.mp2_humidity = mp2_humidity;
-	g_app_sensor_data.mp1_is_tilt_alert = mp1_is_tilt_alert;
-	g_app_sensor_data.mp2_is_tilt_alert = mp2_is_tilt_alert;
+	k_mutex_unlock(&m_sample_lock);
 
+	/* Changes are reported as soon as sampled rather than with the next report */
+	if (g_app_config.report_delta && g_app_config.interval_sample && m_reported_at >= 0 &&
+	    is_moved_since_report()) {
+#if defined(CONFIG_LORAWAN)
+		app_lrw_send();
+#endif /* defined(CONFIG_LORAWAN) */
+	}
+}
+
+bool app_sensor_is_report_due(void)
+{
+	if (!g_app_config.report_delta || m_reported_at < 0 ||
+	    k_uptime_get() - m_reported_at >= g_app_config.report_heartbeat * 1000LL) {
+		return true;
+	}
+
+	return is_moved_since_report();
+}
+
+void app_sensor_set_reported(void)
+{
+	k_mutex_lock(&g_app_sensor_data_lock, K_FOREVER);
+	m_reported = g_app_sensor_data;
 	k_mutex_unlock(&g_app_sensor_data_lock);
+
+	m_reported_alarms = app_alarm_get_state();
+	m_reported_at = k_uptime_get();
 }
@@ -26,14 +26,11 @@ struct app_sensor_data {
 	float illuminance;
 	float altitude;
 	float pressure;
-	float t1_temperature;
-	float t2_temperature;
-	float mp1_temperature;
-	float mp2_temperature;
-	float mp1_humidity;
-	float mp2_humidity;
-	bool mp1_is_tilt_alert;
-	bool mp2_is_tilt_alert;
+	/* Per 1-Wire slot, the first two are T1/T2 and MP1/MP2 */
+	float t_temperature[CONFIG_APP_DS18B20_COUNT];
+	float mp_temperature[CONFIG_APP_MACHINE_PROBE_COUNT];
+	float mp_humidity[CONFIG_APP_MACHINE_PROBE_COUNT];
+	bool mp_is_tilt_alert[CONFIG_APP_MACHINE_PROBE_COUNT];
 	uint32_t hall_left_count;
 	uint32_t hall_right_count;
 	bool hall_left_is_active;
@@ -51,6 +48,11 @@ extern struct k_mutex g_app_sensor_data_lock;
 int app_sensor_init(void);
 void app_sensor_sample(void);
 
+/* Whether the readings moved enough since the last report (or the heartbeat is due) */
+bool app_sensor_is_report_due(void);
+/* Remember the current readings as the reported ones */
+void app_sensor_set_reported(void);
+
 #ifdef __cplusplus
 }
 #endif
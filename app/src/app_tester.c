@@ -21,6 +21,7 @@
 #include <zephyr/sys/util.h>
 
 /* Standard includes */
+#include <errno.h>
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
@@ -307,22 +308,22 @@ static void cmd_check_sensor(const struct shell *shell, size_t argc, char **argv
 		prev_float = g_app_sensor_data.illuminance;
 		is_float = true;
 	} else if (strcmp(sensor_name, "t1-temperature") == 0) {
-		prev_float = g_app_sensor_data.t1_temperature;
+		prev_float = g_app_sensor_data.t_temperature[0];
 		is_float = true;
 	} else if (strcmp(sensor_name, "t2-temperature") == 0) {
-		prev_float = g_app_sensor_data.t2_temperature;
+		prev_float = g_app_sensor_data.t_temperature[1];
 		is_float = true;
 	} else if (strcmp(sensor_name, "mp1-temperature") == 0) {
-		prev_float = g_app_sensor_data.mp1_temperature;
+		prev_float = g_app_sensor_data.mp_temperature[0];
 		is_float = true;
 	} else if (strcmp(sensor_name, "mp2-temperature") == 0) {
-		prev_float = g_app_sensor_data.mp2_temperature;
+		prev_float = g_app_sensor_data.mp_temperature[1];
 		is_float = true;
 	} else if (strcmp(sensor_name, "mp1-humidity") == 0) {
-		prev_float = g_app_sensor_data.mp1_humidity;
+		prev_float = g_app_sensor_data.mp_humidity[0];
 		is_float = true;
 	} else if (strcmp(sensor_name, "mp2-humidity") == 0) {
-		prev_float = g_app_sensor_data.mp2_humidity;
+		prev_float = g_app_sensor_data.mp_humidity[1];
 		is_float = true;
 	} else if (strcmp(sensor_name, "altitude") == 0) {
 		prev_float = g_app_sensor_data.altitude;
@@ -349,10 +350,10 @@ static void cmd_check_sensor(const struct shell *shell, size_t argc, char **argv
 		prev_uint32 = g_app_sensor_data.input_b_count;
 		is_uint32 = true;
 	} else if (strcmp(sensor_name, "mp1-is-tilt-alert") == 0) {
-		prev_bool = g_app_sensor_data.mp1_is_tilt_alert;
+		prev_bool = g_app_sensor_data.mp_is_tilt_alert[0];
 		is_bool = true;
 	} else if (strcmp(sensor_name, "mp2-is-tilt-alert") == 0) {
-		prev_bool = g_app_sensor_data.mp2_is_tilt_alert;
+		prev_bool = g_app_sensor_data.mp_is_tilt_alert[1];
 		is_bool = true;
 	} else if (strcmp(sensor_name, "hall-left-is-active") == 0) {
 		prev_bool = g_app_sensor_data.hall_left_is_active;
@@ -401,17 +402,17 @@ static void cmd_check_sensor(const struct shell *shell, size_t argc, char **argv
 			} else if (strcmp(sensor_name, "illuminance") == 0) {
 				curr_float = g_app_sensor_data.illuminance;
 			} else if (strcmp(sensor_name, "t1-temperature") == 0) {
-				curr_float = g_app_sensor_data.t1_temperature;
+				curr_float = g_app_sensor_data.t_temperature[0];
 			} else if (strcmp(sensor_name, "t2-temperature") == 0) {
-				curr_float = g_app_sensor_data.t2_temperature;
+				curr_float = g_app_sensor_data.t_temperature[1];
 			} else if (strcmp(sensor_name, "mp1-temperature") == 0) {
-				curr_float = g_app_sensor_data.mp1_temperature;
+				curr_float = g_app_sensor_data.mp_temperature[0];
 			} else if (strcmp(sensor_name, "mp2-temperature") == 0) {
-				curr_float = g_app_sensor_data.mp2_temperature;
+				curr_float = g_app_sensor_data.mp_temperature[1];
 			} else if (strcmp(sensor_name, "mp1-humidity") == 0) {
-				curr_float = g_app_sensor_data.mp1_humidity;
+				curr_float = g_app_sensor_data.mp_humidity[0];
 			} else if (strcmp(sensor_name, "mp2-humidity") == 0) {
-				curr_float = g_app_sensor_data.mp2_humidity;
+				curr_float = g_app_sensor_data.mp_humidity[1];
 			} else if (strcmp(sensor_name, "altitude") == 0) {
 				curr_float = g_app_sensor_data.altitude;
 			} else if (strcmp(sensor_name, "pressure") == 0) {
@@ -452,9 +453,9 @@ static void cmd_check_sensor(const struct shell *shell, size_t argc, char **argv
 			}
 		} else if (is_bool) {
 			if (strcmp(sensor_name, "mp1-is-tilt-alert") == 0) {
-				curr_bool = g_app_sensor_data.mp1_is_tilt_alert;
+				curr_bool = g_app_sensor_data.mp_is_tilt_alert[0];
 			} else if (strcmp(sensor_name, "mp2-is-tilt-alert") == 0) {
-				curr_bool = g_app_sensor_data.mp2_is_tilt_alert;
+				curr_bool = g_app_sensor_data.mp_is_tilt_alert[1];
 			} else if (strcmp(sensor_name, "hall-left-is-active") == 0) {
 				curr_bool = g_app_sensor_data.hall_left_is_active;
 			} else if (strcmp(sensor_name, "hall-right-is-active") == 0) {
@@ -481,6 +482,76 @@ static void cmd_check_sensor(const struct shell *shell, size_t argc, char **argv
 	shell_print(shell, SHELL_PFX " Monitoring timeout");
 }
 
+static int cmd_print_wakeups(const struct shell *shell, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	uint32_t wakeups;
+	uint32_t seconds;
+
+	app_hall_get_wakeups(&wakeups, &seconds);
+
+	/* Strobing both switches every 100 ms results in 36000 wakeups per hour */
+	shell_print(shell, SHELL_PFX " Hall wakeups: %u in %u s (%u per hour)", wakeups, seconds,
+		    seconds ? (uint32_t)((uint64_t)wakeups * 3600 / seconds) : 0);
+
+	return 0;
+}
+
+static int cmd_bench_machine_probe(const struct shell *shell, size_t argc, char **argv)
+{
+	int ret;
+	int count = 10;
+
+	if (argc >= 2) {
+		count = atoi(argv[1]);
+		if (count <= 0) {
+			shell_error(shell, "Invalid count value");
+			return -EINVAL;
+		}
+	}
+
+	uint64_t serial_numbers[CONFIG_APP_MACHINE_PROBE_COUNT];
+	float temperatures[CONFIG_APP_MACHINE_PROBE_COUNT];
+	float humidities[CONFIG_APP_MACHINE_PROBE_COUNT];
+	bool is_tilt_alerts[CONFIG_APP_MACHINE_PROBE_COUNT];
+
+	uint32_t readings_start;
+	uint64_t bus_time_start;
+	app_machine_probe_get_bus_time(&readings_start, &bus_time_start);
+
+	int64_t start_time = k_uptime_get();
+
+	for (int i = 0; i < count; i++) {
+		ret = app_machine_probe_read_all(serial_numbers, temperatures, humidities,
+						 is_tilt_alerts, CONFIG_APP_MACHINE_PROBE_COUNT);
+		if (ret) {
+			shell_error(shell, "Failed to read Machine Probes: %d", ret);
+			return ret;
+		}
+	}
+
+	int64_t elapsed = k_uptime_get() - start_time;
+
+	uint32_t readings;
+	uint64_t bus_time;
+	app_machine_probe_get_bus_time(&readings, &bus_time);
+
+	readings -= readings_start;
+	bus_time -= bus_time_start;
+
+	if (!readings) {
+		shell_error(shell, "No Machine Probe read");
+		return -ENODEV;
+	}
+
+	shell_print(shell, SHELL_PFX " Machine Probe readings: %u in %lld ms", readings, elapsed);
+	shell_print(shell, SHELL_PFX " 1-Wire time per reading: %llu us", bus_time / readings);
+
+	return 0;
+}
+
 static int cmd_print_sample(const struct shell *shell, size_t argc, char **argv)
 {
 	ARG_UNUSED(argc);
@@ -496,24 +567,24 @@ static int cmd_print_sample(const struct shell *shell, size_t argc, char **argv)
 	shell_print(shell, "illuminance:              %.2f lux",
 		    (double)g_app_sensor_data.illuminance);
 	shell_print(shell, "t1-temperature:           %.2f C",
-		    (double)g_app_sensor_data.t1_temperature);
+		    (double)g_app_sensor_data.t_temperature[0]);
 	shell_print(shell, "t2-temperature:           %.2f C",
-		    (double)g_app_sensor_data.t2_temperature);
+		    (double)g_app_sensor_data.t_temperature[1]);
 	shell_print(shell, "motion-count:             %u", g_app_sensor_data.motion_count);
 	shell_print(shell, "altitude:                 %.2f m", (double)g_app_sensor_data.altitude);
 	shell_print(shell, "pressure:                 %.2f Pa", (double)g_app_sensor_data.pressure);
 	shell_print(shell, "mp1-temperature:          %.2f C",
-		    (double)g_app_sensor_data.mp1_temperature);
+		    (double)g_app_sensor_data.mp_temperature[0]);
 	shell_print(shell, "mp2-temperature:          %.2f C",
-		    (double)g_app_sensor_data.mp2_temperature);
+		    (double)g_app_sensor_data.mp_temperature[1]);
 	shell_print(shell, "mp1-humidity:             %.2f %%",
-		    (double)g_app_sensor_data.mp1_humidity);
+		    (double)g_app_sensor_data.mp_humidity[0]);
 	shell_print(shell, "mp2-humidity:             %.2f %%",
-		    (double)g_app_sensor_data.mp2_humidity);
+		    (double)g_app_sensor_data.mp_humidity[1]);
 	shell_print(shell, "mp1-is-tilt-alert:        %s",
-		    g_app_sensor_data.mp1_is_tilt_alert ? "true" : "false");
+		    g_app_sensor_data.mp_is_tilt_alert[0] ? "true" : "false");
 	shell_print(shell, "mp2-is-tilt-alert:        %s",
-		    g_app_sensor_data.mp2_is_tilt_alert ? "true" : "false");
+		    g_app_sensor_data.mp_is_tilt_alert[1] ? "true" : "false");
 	shell_print(shell, "hall-left-count:          %u", g_app_sensor_data.hall_left_count);
 	shell_print(shell, "hall-right-count:         %u", g_app_sensor_data.hall_right_count);
 	shell_print(shell, "hall-left-is-active:      %s",
@@ -598,6 +669,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_sensors,
 		      0),
 	SHELL_CMD_ARG(check, NULL, "Monitor sensor for changes. Usage: check <sensor> [timeout]",
 		      cmd_check_sensor, 2, 1),
+	SHELL_CMD_ARG(wakeups, NULL, "Print sensor wakeups per hour.", cmd_print_wakeups, 1, 0),
+	SHELL_CMD_ARG(w1-bench, NULL, "Measure 1-Wire time per Machine Probe reading. Usage: "
+		      "w1-bench [count]", cmd_bench_machine_probe, 1, 1),
 	SHELL_SUBCMD_SET_END);
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_led,
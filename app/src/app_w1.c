@@ -5,29 +5,54 @@
  */
 
 #include "app_w1.h"
+#include "app_config.h"
 #include "app_log.h"
 
 /* Zephyr includes */
 #include <zephyr/device.h>
 #include <zephyr/drivers/w1.h>
+#include <zephyr/init.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/pm/device.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
 
 /* Standard includes */
 #include <errno.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 LOG_MODULE_REGISTER(app_w1, LOG_LEVEL_DBG);
 
 #define ACQUIRE_DELAY K_MSEC(3)
 
-struct scan_item {
-	struct w1_rom rom;
-	sys_snode_t node;
+#define SETTINGS_PFX "w1"
+#define SETTINGS_KEY "roms"
+
+/* Devices added next to already known ones are only found by a full search */
+#define SEARCH_INTERVAL_SEC 3600
+
+struct scan_ctx {
+	struct app_w1 *w1;
+	struct w1_rom *roms;
+	int size;
+	int count;
 };
 
+/* Topology (ROMs in search order) found by the last full search, persisted in settings */
+static struct w1_rom m_roms[APP_W1_SCAN_MAX];
+static int m_rom_count;
+static int64_t m_search_at;
+static atomic_t m_is_changed;
+
+/* Presence pulse seen on the last bus reset */
+static bool m_is_present;
+
 int app_w1_acquire(struct app_w1 *w1, const struct device *dev)
 {
 	int ret;
@@ -64,6 +89,8 @@ int app_w1_acquire(struct app_w1 *w1, const struct device *dev)
 		goto error;
 	}
 
+	m_is_present = ret > 0;
+
 	return 0;
 
 error:
@@ -122,48 +149,70 @@ error:
 
 static void w1_search_callback(struct w1_rom rom, void *cb_arg)
 {
-	struct app_w1 *w1 = cb_arg;
+	struct scan_ctx *ctx = cb_arg;
 
 	if (rom.family == 0x19) {
-		w1->is_ds28e17_present = true;
+		ctx->w1->is_ds28e17_present = true;
+	}
+
+	/* Devices beyond the capacity are counted only */
+	if (ctx->count < ctx->size) {
+		ctx->roms[ctx->count] = rom;
 	}
 
-	struct scan_item *item = k_malloc(sizeof(*item));
-	if (!item) {
-		LOG_ERR_CALL_FAILED("k_malloc");
+	ctx->count++;
+}
+
+static void update_topology(const struct w1_rom *roms, int count)
+{
+	int ret;
+
+	m_search_at = k_uptime_get();
+
+	if (count == m_rom_count && !memcmp(roms, m_roms, count * sizeof(roms[0]))) {
 		return;
 	}
 
-	item->rom = rom;
+	LOG_INF("Topology changed: %d device(s)", count);
+
+	memcpy(m_roms, roms, count * sizeof(roms[0]));
+	m_rom_count = count;
 
-	sys_slist_append(&w1->scan_list, &item->node);
+	atomic_set(&m_is_changed, true);
+
+	ret = settings_save_one(SETTINGS_PFX "/" SETTINGS_KEY, m_roms, count * sizeof(m_roms[0]));
+	if (ret) {
+		LOG_ERR("Call `settings_save_one` failed: %d", ret);
+	}
 }
 
-int app_w1_scan(struct app_w1 *w1, const struct device *dev,
+int app_w1_scan(struct app_w1 *w1, const struct device *dev, struct w1_rom *roms, int size,
 		int (*user_cb)(struct w1_rom rom, void *user_data), void *user_data)
 {
 	int ret;
 	int res = 0;
 
-	w1->is_ds28e17_present = false;
+	struct scan_ctx ctx = {.w1 = w1, .roms = roms, .size = size};
 
-	sys_slist_init(&w1->scan_list);
+	w1->is_ds28e17_present = false;
 
-	ret = w1_search_rom(dev, w1_search_callback, w1);
+	ret = w1_search_rom(dev, w1_search_callback, &ctx);
 	if (ret < 0) {
 		LOG_ERR_CALL_FAILED_INT("w1_search_rom", ret);
-		res = ret;
-		goto error;
+		return ret;
 	}
 
-	LOG_DBG("Found %d device(s)", ret);
+	LOG_DBG("Found %d device(s)", ctx.count);
+
+	if (ctx.count > size) {
+		LOG_WRN("Too many devices: %d (capacity: %d)", ctx.count, size);
+	}
 
-	struct scan_item *item;
-	struct scan_item *item_safe;
+	update_topology(roms, MIN(ctx.count, MIN(size, (int)ARRAY_SIZE(m_roms))));
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&w1->scan_list, item, item_safe, node) {
+	for (int i = 0; i < MIN(ctx.count, size); i++) {
 		if (user_cb) {
-			ret = user_cb(item->rom, user_data);
+			ret = user_cb(roms[i], user_data);
 			if (ret) {
 				LOG_ERR_CALL_FAILED_INT("user_cb", ret);
 				res = res ? res : ret;
@@ -171,11 +220,190 @@ int app_w1_scan(struct app_w1 *w1, const struct device *dev,
 		}
 	}
 
-error:
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&w1->scan_list, item, item_safe, node) {
-		sys_slist_remove(&w1->scan_list, NULL, &item->node);
-		k_free(item);
+	return res ? res : ctx.count;
+}
+
+bool app_w1_is_search_due(void)
+{
+	/* Devices answer the reset while none are known, or all known devices are gone */
+	if (m_is_present != (m_rom_count > 0)) {
+		return true;
+	}
+
+	return k_uptime_get() - m_search_at >= SEARCH_INTERVAL_SEC * 1000LL;
+}
+
+bool app_w1_is_topology_changed(bool clear)
+{
+	return clear ? atomic_clear(&m_is_changed) : atomic_get(&m_is_changed);
+}
+
+int app_w1_get_device_count(void)
+{
+	return m_rom_count;
+}
+
+BUILD_ASSERT(SIZEOF_FIELD(struct app_config, rom_t1) == sizeof(struct w1_rom));
+
+static uint8_t *get_binding(struct app_config *config, const struct app_w1_binding *binding)
+{
+	return (uint8_t *)config + binding->offset;
+}
+
+static int bind(const struct app_w1_binding *binding, const struct w1_rom *rom)
+{
+	int ret;
+
+	/* Pending configuration as well, so saving it later keeps the binding */
+	memcpy(get_binding(&g_app_config, binding), rom, sizeof(*rom));
+	memcpy(get_binding(app_config(), binding), rom, sizeof(*rom));
+
+	ret = settings_save_one(binding->key, rom, sizeof(*rom));
+	if (ret) {
+		LOG_ERR("Call `settings_save_one` failed: %d", ret);
+		return ret;
+	}
+
+	LOG_INF("Bound serial number %llu to %s", sys_get_le48(rom->serial), binding->key);
+
+	return 0;
+}
+
+static bool is_unbound(const struct app_w1_binding *binding)
+{
+	static const struct w1_rom empty;
+
+	return !memcmp(get_binding(&g_app_config, binding), &empty, sizeof(empty));
+}
+
+/* Unbound slots are preferred over the slots of probes which were not found */
+static int get_free_slot(const struct app_w1_binding *bindings, const int *slots, int count)
+{
+	int slot = -1;
+
+	for (int i = 0; i < count; i++) {
+		if (slots[i] >= 0) {
+			continue;
+		}
+
+		if (is_unbound(&bindings[i])) {
+			return i;
+		}
+
+		if (slot < 0) {
+			slot = i;
+		}
+	}
+
+	return slot;
+}
+
+int app_w1_bind(const struct app_w1_binding *bindings, int *slots, int count,
+		const struct w1_rom *roms, int rom_count)
+{
+	int ret;
+	int res = 0;
+
+	bool is_bound[APP_W1_SCAN_MAX] = {0};
+
+	rom_count = MIN(rom_count, (int)ARRAY_SIZE(is_bound));
+
+	for (int i = 0; i < count; i++) {
+		const uint8_t *binding = get_binding(&g_app_config, &bindings[i]);
+
+		slots[i] = -1;
+
+		for (int j = 0; j < rom_count; j++) {
+			if (!is_bound[j] && !memcmp(binding, &roms[j], sizeof(roms[j]))) {
+				slots[i] = j;
+				is_bound[j] = true;
+				break;
+			}
+		}
+	}
+
+	for (int j = 0; j < rom_count; j++) {
+		if (is_bound[j]) {
+			continue;
+		}
+
+		int i = get_free_slot(bindings, slots, count);
+		if (i < 0) {
+			LOG_WRN("No more space for additional device: %llu",
+				sys_get_le48(roms[j].serial));
+			continue;
+		}
+
+		if (!is_unbound(&bindings[i])) {
+			LOG_WRN("Rebinding %s (bound probe not found)", bindings[i].key);
+		}
+
+		ret = bind(&bindings[i], &roms[j]);
+		if (ret) {
+			LOG_ERR_CALL_FAILED_INT("bind", ret);
+			res = res ? res : ret;
+		}
+
+		slots[i] = j;
 	}
 
 	return res;
 }
+
+static int h_set(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg)
+{
+	int ret;
+	const char *next;
+
+	if (!settings_name_steq(key, SETTINGS_KEY, &next) || next) {
+		return -ENOENT;
+	}
+
+	if (len % sizeof(m_roms[0]) || len > sizeof(m_roms)) {
+		return -EINVAL;
+	}
+
+	ret = read_cb(cb_arg, m_roms, len);
+	if (ret < 0) {
+		LOG_ERR("Call `read_cb` failed: %d", ret);
+		return ret;
+	}
+
+	m_rom_count = len / sizeof(m_roms[0]);
+
+	return 0;
+}
+
+static int app_w1_init(void)
+{
+	int ret;
+
+	ret = settings_subsys_init();
+	if (ret) {
+		LOG_ERR("Call `settings_subsys_init` failed: %d", ret);
+		return ret;
+	}
+
+	static struct settings_handler sh = {
+		.name = SETTINGS_PFX,
+		.h_set = h_set,
+	};
+
+	ret = settings_register(&sh);
+	if (ret) {
+		LOG_ERR("Call `settings_register` failed: %d", ret);
+		return ret;
+	}
+
+	ret = settings_load_subtree(SETTINGS_PFX);
+	if (ret) {
+		LOG_ERR("Call `settings_load_subtree` failed: %d", ret);
+		return ret;
+	}
+
+	LOG_INF("Loaded topology: %d device(s)", m_rom_count);
+
+	return 0;
+}
+
+SYS_INIT(app_w1_init, APPLICATION, 1);
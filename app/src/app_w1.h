@@ -14,21 +14,43 @@
 
 /* Standard includes */
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Capacity of the scan buffers of the bus users */
+#define APP_W1_SCAN_MAX 16
+
 struct app_w1 {
-	sys_slist_t scan_list;
 	bool is_ds28e17_present;
 };
 
 int app_w1_acquire(struct app_w1 *w1, const struct device *dev);
 int app_w1_release(struct app_w1 *w1, const struct device *dev);
-int app_w1_scan(struct app_w1 *w1, const struct device *dev,
+/* Search the bus into the roms array of the given size and call user_cb for each stored ROM.
+ * Returns the number of devices found (may exceed size) or a negative error code */
+int app_w1_scan(struct app_w1 *w1, const struct device *dev, struct w1_rom *roms, int size,
 		int (*user_cb)(struct w1_rom rom, void *user_data), void *user_data);
 
+/* Whether the presence pulse disagrees with the cached topology or the periodic search is due */
+bool app_w1_is_search_due(void);
+/* Whether a search found a topology different from the cached one (since the last clear) */
+bool app_w1_is_topology_changed(bool clear);
+int app_w1_get_device_count(void);
+
+/* Configuration parameter (ROM sized member of struct app_config) binding a probe to a slot */
+struct app_w1_binding {
+	const char *key;
+	size_t offset;
+};
+
+/* Assign the found ROMs to the slots of the bindings, probes keep the slot they are bound to and
+ * new probes are bound (persistently) to free slots. Fills slots with the ROM index or -1 */
+int app_w1_bind(const struct app_w1_binding *bindings, int *slots, int count,
+		const struct w1_rom *roms, int rom_count);
+
 #ifdef __cplusplus
 }
 #endif
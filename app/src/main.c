@@ -11,6 +11,7 @@
 #include "app_led.h"
 #include "app_log.h"
 #include "app_lrw.h"
+#include "app_main.h"
 #include "app_nfc.h"
 #include "app_sensor.h"
 #include "app_settings.h"
@@ -25,20 +26,42 @@
 
 /* Standard includes */
 #include <errno.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
 LOG_MODULE_REGISTER(main, LOG_LEVEL_DBG);
 
-#define BLINK_INTERVAL_SECONDS 3
-#define NFC_CHECK_BLINKS       10
+/* Task intervals are multiples of the blink interval so that the wakeups coincide */
+#define BLINK_INTERVAL_SECONDS             3
+#define HEARTBEAT_INTERVAL_SECONDS         30
+#define WDOG_FEED_INTERVAL_SECONDS         6
+#define NFC_CHECK_INTERVAL_SECONDS         30
+#define NFC_IDLE_CHECK_INTERVAL_SECONDS    120
+#define CALIBRATION_CHECK_INTERVAL_SECONDS 3
+
+/* NFC is checked more often while the device is likely being commissioned after boot */
+#define NFC_COMMISSIONING_WINDOW_MIN 10
+
+/* Tasks due within this time run together with the current wakeup */
+#define TASK_COALESCE_MSEC 500
 
 enum app_mode {
 	APP_MODE_NORMAL = 0,
 	APP_MODE_CALIBRATION,
 };
 
-static int m_nfc_counter;
+struct task {
+	const char *name;
+	/* Events which make the task run immediately */
+	uint32_t events;
+	/* Returns the interval in seconds to the next run, 0 when the task is not needed anymore */
+	int (*handler)(void);
+	/* Uptime in milliseconds of the next run */
+	int64_t deadline;
+};
+
+static K_EVENT_DEFINE(m_events);
 
 static void die(void)
 {
@@ -102,6 +125,220 @@ static int init(void)
 
 SYS_INIT(init, POST_KERNEL, 0);
 
+/* Blinks fast only while the join state or an active alarm needs attention, otherwise the
+ * green heartbeat is stretched */
+static int task_led(void)
+{
+	LOG_INF("Alive");
+
+	bool led_handled = false;
+
+#if defined(CONFIG_LORAWAN)
+	enum app_lrw_state lrw_state = app_lrw_get_state();
+
+	if (lrw_state == APP_LRW_STATE_JOINING ||
+	    lrw_state == APP_LRW_STATE_RECONNECT) {
+		struct app_led_play_req req = {
+			.commands = {
+				{.type = APP_LED_CMD_SET, .set = {APP_LED_CHANNEL_Y, APP_LED_ON}},
+				{.type = APP_LED_CMD_DELAY, .duration = 10},
+				{.type = APP_LED_CMD_SET, .set = {APP_LED_CHANNEL_Y, APP_LED_OFF}},
+				{.type = APP_LED_CMD_DELAY, .duration = 200},
+				{.type = APP_LED_CMD_SET, .set = {APP_LED_CHANNEL_Y, APP_LED_ON}},
+				{.type = APP_LED_CMD_DELAY, .duration = 10},
+				{.type = APP_LED_CMD_SET, .set = {APP_LED_CHANNEL_Y, APP_LED_OFF}},
+				{.type = APP_LED_CMD_DELAY, .duration = 200},
+				{.type = APP_LED_CMD_SET, .set = {APP_LED_CHANNEL_R, APP_LED_ON}},
+				{.type = APP_LED_CMD_DELAY, .duration = 80},
+				{.type = APP_LED_CMD_SET, .set = {APP_LED_CHANNEL_R, APP_LED_OFF}},
+				{.type = APP_LED_CMD_END}},
+			.repetitions = 1};
+		app_led_play(&req);
+		led_handled = true;
+	} else if (lrw_state == APP_LRW_STATE_WARNING) {
+		struct app_led_blink_req req = {.color = APP_LED_CHANNEL_Y,
+						.duration = 10,
+						.space = 200,
+						.repetitions = 3};
+		app_led_blink(&req);
+		led_handled = true;
+	}
+#endif /* defined(CONFIG_LORAWAN) */
+
+	if (!led_handled && app_alarm_is_active()) {
+		struct app_led_blink_req req = {.color = APP_LED_CHANNEL_R,
+						.duration = 5,
+						.space = 0,
+						.repetitions = 1};
+		app_led_blink(&req);
+		led_handled = true;
+	}
+
+	if (!led_handled) {
+#if defined(CONFIG_FW_DEBUG)
+		/* Debug: green + yellow LED blink */
+		struct app_led_play_req req = {
+			.commands = {
+				{.type = APP_LED_CMD_SET, .set = {APP_LED_CHANNEL_G, APP_LED_ON}},
+				{.type = APP_LED_CMD_DELAY, .duration = 5},
+				{.type = APP_LED_CMD_SET, .set = {APP_LED_CHANNEL_G, APP_LED_OFF}},
+				{.type = APP_LED_CMD_DELAY, .duration = 50},
+				{.type = APP_LED_CMD_SET, .set = {APP_LED_CHANNEL_Y, APP_LED_ON}},
+				{.type = APP_LED_CMD_DELAY, .duration = 5},
+				{.type = APP_LED_CMD_SET, .set = {APP_LED_CHANNEL_Y, APP_LED_OFF}},
+				{.type = APP_LED_CMD_END}},
+			.repetitions = 1};
+		app_led_play(&req);
+#else
+		/* Release: green LED blink */
+		struct app_led_blink_req req = {.color = APP_LED_CHANNEL_G,
+						.duration = 5,
+						.space = 0,
+						.repetitions = 1};
+		app_led_blink(&req);
+#endif /* defined(CONFIG_FW_DEBUG) */
+	}
+
+	return led_handled ? BLINK_INTERVAL_SECONDS : HEARTBEAT_INTERVAL_SECONDS;
+}
+
+#if defined(CONFIG_WATCHDOG)
+static int task_wdog(void)
+{
+	int ret = app_wdog_feed();
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("app_wdog_feed", ret);
+	}
+
+	return WDOG_FEED_INTERVAL_SECONDS;
+}
+#endif /* defined(CONFIG_WATCHDOG) */
+
+static int get_nfc_interval(void)
+{
+	if (k_uptime_get() < (int64_t)NFC_COMMISSIONING_WINDOW_MIN * 60 * 1000) {
+		return NFC_CHECK_INTERVAL_SECONDS;
+	}
+
+	return NFC_IDLE_CHECK_INTERVAL_SECONDS;
+}
+
+static int task_nfc(void)
+{
+	int ret;
+	enum app_nfc_action action;
+
+	ret = app_nfc_check(&action);
+	if (ret) {
+		LOG_ERR_CALL_FAILED_INT("app_nfc_check", ret);
+		return get_nfc_interval();
+	}
+
+	if (action == APP_NFC_ACTION_SAVE) {
+		play_carousel_nfc();
+
+		ret = app_settings_save();
+		if (ret) {
+			LOG_ERR_CALL_FAILED_INT("app_settings_save", ret);
+		}
+	} else if (action == APP_NFC_ACTION_RESET) {
+		play_carousel_nfc();
+
+		ret = app_settings_reset();
+		if (ret) {
+			LOG_ERR_CALL_FAILED_INT("app_settings_reset", ret);
+		}
+	}
+
+	return get_nfc_interval();
+}
+
+static int task_calibration(void)
+{
+	/* Detect magnet on BOTH Hall sensors → reboot into calibration mode */
+	if (k_uptime_get() >= (int64_t)APP_CALIBRATION_ACTIVATION_WINDOW_MIN * 60 * 1000) {
+		LOG_INF("Calibration activation window elapsed");
+		return 0;
+	}
+
+	app_calibration_check_trigger();
+
+	return CALIBRATION_CHECK_INTERVAL_SECONDS;
+}
+
+static struct task m_tasks[] = {
+#if defined(CONFIG_WATCHDOG)
+	{
+		.name = "wdog",
+		.handler = task_wdog,
+	},
+#endif /* defined(CONFIG_WATCHDOG) */
+	{
+		.name = "nfc",
+		.handler = task_nfc,
+		.deadline = NFC_CHECK_INTERVAL_SECONDS * 1000,
+	},
+	{
+		.name = "calibration",
+		.handler = task_calibration,
+	},
+	{
+		.name = "led",
+		.events = APP_MAIN_EVENT_LRW_STATE | APP_MAIN_EVENT_ALARM,
+		.handler = task_led,
+	},
+};
+
+/* Sleep until the nearest task deadline or event, then run every task due (or nearly due) */
+static void run(void)
+{
+	for (;;) {
+		int64_t now = k_uptime_get();
+		int64_t deadline = INT64_MAX;
+
+		for (size_t i = 0; i < ARRAY_SIZE(m_tasks); i++) {
+			deadline = MIN(deadline, m_tasks[i].deadline);
+		}
+
+		k_timeout_t timeout = deadline == INT64_MAX ? K_FOREVER
+							    : K_MSEC(MAX(deadline - now, 0));
+
+		uint32_t events = k_event_wait(&m_events, UINT32_MAX, false, timeout);
+
+		k_event_clear(&m_events, events);
+
+		now = k_uptime_get();
+
+		for (size_t i = 0; i < ARRAY_SIZE(m_tasks); i++) {
+			struct task *task = &m_tasks[i];
+
+			bool is_due = task->deadline <= now + TASK_COALESCE_MSEC;
+
+			if (!is_due && !(events & task->events)) {
+				continue;
+			}
+
+			int interval = task->handler();
+
+			if (!interval) {
+				LOG_DBG("Task %s finished", task->name);
+				task->deadline = INT64_MAX;
+			} else if (is_due) {
+				task->deadline = now + interval * 1000;
+			} else {
+				/* Runs on events keep the deadline so that the wakeups stay
+				 * aligned, unless the task asks for a faster pace */
+				task->deadline = MIN(task->deadline, now + interval * 1000);
+			}
+		}
+	}
+}
+
+void app_main_post(uint32_t events)
+{
+	k_event_post(&m_events, events);
+}
+
 int main(void)
 {
 	int ret;
@@ -214,116 +451,7 @@ int main(void)
 #endif /* defined(CONFIG_LORAWAN) */
 
 	/* Normal mode main loop */
-	for (;;) {
-		LOG_INF("Alive");
-
-#if defined(CONFIG_WATCHDOG)
-		ret = app_wdog_feed();
-		if (ret) {
-			LOG_ERR_CALL_FAILED_INT("app_wdog_feed", ret);
-		}
-#endif /* defined(CONFIG_WATCHDOG) */
-
-		if (++m_nfc_counter >= NFC_CHECK_BLINKS) {
-			m_nfc_counter = 0;
-
-			ret = app_nfc_check(&action);
-			if (ret) {
-				LOG_ERR_CALL_FAILED_INT("app_nfc_check", ret);
-			}
-
-			if (action == APP_NFC_ACTION_SAVE) {
-				play_carousel_nfc();
-
-				ret = app_settings_save();
-				if (ret) {
-					LOG_ERR_CALL_FAILED_INT("app_settings_save", ret);
-				}
-			} else if (action == APP_NFC_ACTION_RESET) {
-				play_carousel_nfc();
-
-				ret = app_settings_reset();
-				if (ret) {
-					LOG_ERR_CALL_FAILED_INT("app_settings_reset", ret);
-				}
-			}
-		}
-
-		/* Detect magnet on BOTH Hall sensors → reboot into calibration mode */
-		if (k_uptime_get() < (int64_t)APP_CALIBRATION_ACTIVATION_WINDOW_MIN * 60 * 1000) {
-			app_calibration_check_trigger();
-		}
-
-		bool led_handled = false;
-
-#if defined(CONFIG_LORAWAN)
-		enum app_lrw_state lrw_state = app_lrw_get_state();
-
-		if (lrw_state == APP_LRW_STATE_JOINING ||
-		    lrw_state == APP_LRW_STATE_RECONNECT) {
-			struct app_led_play_req req = {
-				.commands = {
-					{.type = APP_LED_CMD_SET, .set = {APP_LED_CHANNEL_Y, APP_LED_ON}},
-					{.type = APP_LED_CMD_DELAY, .duration = 10},
-					{.type = APP_LED_CMD_SET, .set = {APP_LED_CHANNEL_Y, APP_LED_OFF}},
-					{.type = APP_LED_CMD_DELAY, .duration = 200},
-					{.type = APP_LED_CMD_SET, .set = {APP_LED_CHANNEL_Y, APP_LED_ON}},
-					{.type = APP_LED_CMD_DELAY, .duration = 10},
-					{.type = APP_LED_CMD_SET, .set = {APP_LED_CHANNEL_Y, APP_LED_OFF}},
-					{.type = APP_LED_CMD_DELAY, .duration = 200},
-					{.type = APP_LED_CMD_SET, .set = {APP_LED_CHANNEL_R, APP_LED_ON}},
-					{.type = APP_LED_CMD_DELAY, .duration = 80},
-					{.type = APP_LED_CMD_SET, .set = {APP_LED_CHANNEL_R, APP_LED_OFF}},
-					{.type = APP_LED_CMD_END}},
-				.repetitions = 1};
-			app_led_play(&req);
-			led_handled = true;
-		} else if (lrw_state == APP_LRW_STATE_WARNING) {
-			struct app_led_blink_req req = {.color = APP_LED_CHANNEL_Y,
-							.duration = 10,
-							.space = 200,
-							.repetitions = 3};
-			app_led_blink(&req);
-			led_handled = true;
-		}
-#endif /* defined(CONFIG_LORAWAN) */
-
-		if (!led_handled && app_alarm_is_active()) {
-			struct app_led_blink_req req = {.color = APP_LED_CHANNEL_R,
-							.duration = 5,
-							.space = 0,
-							.repetitions = 1};
-			app_led_blink(&req);
-			led_handled = true;
-		}
-
-		if (!led_handled) {
-#if defined(CONFIG_FW_DEBUG)
-			/* Debug: green + yellow LED blink */
-			struct app_led_play_req req = {
-				.commands = {
-					{.type = APP_LED_CMD_SET, .set = {APP_LED_CHANNEL_G, APP_LED_ON}},
-					{.type = APP_LED_CMD_DELAY, .duration = 5},
-					{.type = APP_LED_CMD_SET, .set = {APP_LED_CHANNEL_G, APP_LED_OFF}},
-					{.type = APP_LED_CMD_DELAY, .duration = 50},
-					{.type = APP_LED_CMD_SET, .set = {APP_LED_CHANNEL_Y, APP_LED_ON}},
-					{.type = APP_LED_CMD_DELAY, .duration = 5},
-					{.type = APP_LED_CMD_SET, .set = {APP_LED_CHANNEL_Y, APP_LED_OFF}},
-					{.type = APP_LED_CMD_END}},
-				.repetitions = 1};
-			app_led_play(&req);
-#else
-			/* Release: green LED blink */
-			struct app_led_blink_req req = {.color = APP_LED_CHANNEL_G,
-							.duration = 5,
-							.space = 0,
-							.repetitions = 1};
-			app_led_blink(&req);
-#endif /* defined(CONFIG_FW_DEBUG) */
-		}
-
-		k_sleep(K_SECONDS(BLINK_INTERVAL_SECONDS));
-	}
+	run();
 
 	return 0;
 }
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2025 HARDWARIO a.s.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Zephyr includes */
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/counter.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+
+/* Standard includes */
+#include <errno.h>
+#include <stdint.h>
+
+#define DT_DRV_COMPAT hardwario_gpio_pulse_counter
+
+LOG_MODULE_REGISTER(gpio_pulse_counter, CONFIG_COUNTER_LOG_LEVEL);
+
+struct gpio_pulse_config {
+	struct counter_config_info info;
+	struct gpio_dt_spec spec;
+};
+
+struct gpio_pulse_data {
+	struct gpio_callback cb;
+	atomic_t count;
+};
+
+static inline const struct gpio_pulse_config *get_config(const struct device *dev)
+{
+	return dev->config;
+}
+
+static inline struct gpio_pulse_data *get_data(const struct device *dev)
+{
+	return dev->data;
+}
+
+static int gpio_pulse_start(const struct device *dev)
+{
+	int ret;
+
+	ret = gpio_pin_interrupt_configure_dt(&get_config(dev)->spec, GPIO_INT_EDGE_TO_ACTIVE);
+	if (ret) {
+		LOG_ERR("Call `gpio_pin_interrupt_configure_dt` failed: %d", ret);
+		return ret;
+	}
+
+	return 0;
+}
+
+static int gpio_pulse_stop(const struct device *dev)
+{
+	int ret;
+
+	ret = gpio_pin_interrupt_configure_dt(&get_config(dev)->spec, GPIO_INT_DISABLE);
+	if (ret) {
+		LOG_ERR("Call `gpio_pin_interrupt_configure_dt` failed: %d", ret);
+		return ret;
+	}
+
+	atomic_clear(&get_data(dev)->count);
+
+	return 0;
+}
+
+static int gpio_pulse_get_value(const struct device *dev, uint32_t *ticks)
+{
+	*ticks = (uint32_t)atomic_get(&get_data(dev)->count);
+
+	return 0;
+}
+
+static uint32_t gpio_pulse_get_top_value(const struct device *dev)
+{
+	return get_config(dev)->info.max_top_value;
+}
+
+static uint32_t gpio_pulse_get_pending_int(const struct device *dev)
+{
+	return 0;
+}
+
+static const struct counter_driver_api gpio_pulse_driver_api = {
+	.start = gpio_pulse_start,
+	.stop = gpio_pulse_stop,
+	.get_value = gpio_pulse_get_value,
+	.get_top_value = gpio_pulse_get_top_value,
+	.get_pending_int = gpio_pulse_get_pending_int,
+};
+
+static void gpio_pulse_callback(const struct device *port, struct gpio_callback *cb,
+				uint32_t pins)
+{
+	struct gpio_pulse_data *data = CONTAINER_OF(cb, struct gpio_pulse_data, cb);
+
+	atomic_inc(&data->count);
+}
+
+static int gpio_pulse_init(const struct device *dev)
+{
+	int ret;
+
+	const struct gpio_pulse_config *config = get_config(dev);
+	struct gpio_pulse_data *data = get_data(dev);
+
+	if (!gpio_is_ready_dt(&config->spec)) {
+		LOG_ERR("GPIO device not ready");
+		return -ENODEV;
+	}
+
+	ret = gpio_pin_configure_dt(&config->spec, GPIO_INPUT);
+	if (ret) {
+		LOG_ERR("Call `gpio_pin_configure_dt` failed: %d", ret);
+		return ret;
+	}
+
+	gpio_init_callback(&data->cb, gpio_pulse_callback, BIT(config->spec.pin));
+
+	ret = gpio_add_callback_dt(&config->spec, &data->cb);
+	if (ret) {
+		LOG_ERR("Call `gpio_add_callback_dt` failed: %d", ret);
+		return ret;
+	}
+
+	return 0;
+}
+
+#define GPIO_PULSE_INIT(n)                                                                         \
+	static const struct gpio_pulse_config inst_##n##_config = {                                \
+		.info =                                                                            \
+			{                                                                          \
+				.max_top_value = UINT32_MAX,                                       \
+				.freq = 0,                                                         \
+				.flags = COUNTER_CONFIG_INFO_COUNT_UP,                             \
+				.channels = 0,                                                     \
+			},                                                                         \
+		.spec = GPIO_DT_SPEC_INST_GET(n, gpios),                                           \
+	};                                                                                         \
+	static struct gpio_pulse_data inst_##n##_data;                                             \
+	DEVICE_DT_INST_DEFINE(n, gpio_pulse_init, NULL, &inst_##n##_data, &inst_##n##_config,      \
+			      POST_KERNEL, CONFIG_COUNTER_INIT_PRIORITY, &gpio_pulse_driver_api);
+
+DT_INST_FOREACH_STATUS_OKAY(GPIO_PULSE_INIT)
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2025 HARDWARIO a.s.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Zephyr includes */
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/clock_control.h>
+#include <zephyr/drivers/clock_control/stm32_clock_control.h>
+#include <zephyr/drivers/counter.h>
+#include <zephyr/drivers/pinctrl.h>
+#include <zephyr/irq.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+/* STM32 includes */
+#include <stm32_ll_lptim.h>
+
+/* Standard includes */
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define DT_DRV_COMPAT hardwario_stm32_lptim_pulse
+
+LOG_MODULE_REGISTER(stm32_lptim_pulse, CONFIG_COUNTER_LOG_LEVEL);
+
+#define ARR_VALUE 0xffff
+
+struct stm32_lptim_pulse_config {
+	struct counter_config_info info;
+	LPTIM_TypeDef *lptim;
+	struct stm32_pclken pclken;
+	const struct pinctrl_dev_config *pcfg;
+	uint32_t polarity;
+	void (*irq_config)(const struct device *dev);
+};
+
+struct stm32_lptim_pulse_data {
+	/* Auto-reload matches since start, i.e. upper 16 bits once the counter leaves the top */
+	uint32_t overflows;
+	/* Auto-reload value written, matches before hit the reset value of 1 */
+	bool is_reloaded;
+};
+
+static inline const struct stm32_lptim_pulse_config *get_config(const struct device *dev)
+{
+	return dev->config;
+}
+
+static inline struct stm32_lptim_pulse_data *get_data(const struct device *dev)
+{
+	return dev->data;
+}
+
+/* Counter runs asynchronously to the bus clock, read until two consecutive reads match */
+static uint32_t read_counter(LPTIM_TypeDef *lptim)
+{
+	uint32_t cnt;
+
+	do {
+		cnt = LL_LPTIM_GetCounter(lptim);
+	} while (cnt != LL_LPTIM_GetCounter(lptim));
+
+	return cnt;
+}
+
+/* Start counting once the auto-reload write completes, called with interrupts locked */
+static void check_reload(const struct device *dev)
+{
+	LPTIM_TypeDef *lptim = get_config(dev)->lptim;
+
+	if (LL_LPTIM_IsActiveFlag_ARROK(lptim)) {
+		LL_LPTIM_ClearFlag_ARROK(lptim);
+		LL_LPTIM_ClearFlag_ARRM(lptim);
+		get_data(dev)->overflows = 0;
+		get_data(dev)->is_reloaded = true;
+	}
+}
+
+static int stm32_lptim_pulse_start(const struct device *dev)
+{
+	LPTIM_TypeDef *lptim = get_config(dev)->lptim;
+
+	if (LL_LPTIM_IsEnabled(lptim)) {
+		return 0;
+	}
+
+	/* Interrupt enable register is writable only while the timer is disabled */
+	LL_LPTIM_EnableIT_ARRM(lptim);
+	LL_LPTIM_EnableIT_ARROK(lptim);
+
+	get_data(dev)->is_reloaded = false;
+
+	LL_LPTIM_Enable(lptim);
+
+	/* Writes are synchronized with the counter clock, i.e. complete with the first edges
+	 * (cannot be waited for, the counting starts on the write-complete flag instead) */
+	LL_LPTIM_SetAutoReload(lptim, ARR_VALUE);
+	LL_LPTIM_StartCounter(lptim, LL_LPTIM_OPERATING_MODE_CONTINUOUS);
+
+	return 0;
+}
+
+static int stm32_lptim_pulse_stop(const struct device *dev)
+{
+	LPTIM_TypeDef *lptim = get_config(dev)->lptim;
+
+	LL_LPTIM_Disable(lptim);
+	LL_LPTIM_DisableIT_ARRM(lptim);
+	LL_LPTIM_DisableIT_ARROK(lptim);
+
+	get_data(dev)->overflows = 0;
+	get_data(dev)->is_reloaded = false;
+
+	return 0;
+}
+
+static int stm32_lptim_pulse_get_value(const struct device *dev, uint32_t *ticks)
+{
+	LPTIM_TypeDef *lptim = get_config(dev)->lptim;
+
+	unsigned int key = irq_lock();
+
+	check_reload(dev);
+
+	if (!get_data(dev)->is_reloaded) {
+		irq_unlock(key);
+		*ticks = 0;
+		return 0;
+	}
+
+	uint32_t overflows = get_data(dev)->overflows;
+	uint32_t cnt = read_counter(lptim);
+
+	/* Account for a match which has not been serviced yet */
+	if (LL_LPTIM_IsActiveFlag_ARRM(lptim)) {
+		cnt = read_counter(lptim);
+		overflows++;
+	}
+
+	/* Match is flagged when the counter reaches the auto-reload value, the wrap to zero
+	 * happens only with the next edge (the match belongs to the current period until then) */
+	if (cnt == ARR_VALUE && overflows) {
+		overflows--;
+	}
+
+	irq_unlock(key);
+
+	*ticks = (overflows << 16) | cnt;
+
+	return 0;
+}
+
+static uint32_t stm32_lptim_pulse_get_top_value(const struct device *dev)
+{
+	return get_config(dev)->info.max_top_value;
+}
+
+static uint32_t stm32_lptim_pulse_get_pending_int(const struct device *dev)
+{
+	return 0;
+}
+
+static const struct counter_driver_api stm32_lptim_pulse_driver_api = {
+	.start = stm32_lptim_pulse_start,
+	.stop = stm32_lptim_pulse_stop,
+	.get_value = stm32_lptim_pulse_get_value,
+	.get_top_value = stm32_lptim_pulse_get_top_value,
+	.get_pending_int = stm32_lptim_pulse_get_pending_int,
+};
+
+static void stm32_lptim_pulse_isr(const struct device *dev)
+{
+	LPTIM_TypeDef *lptim = get_config(dev)->lptim;
+
+	check_reload(dev);
+
+	if (LL_LPTIM_IsActiveFlag_ARRM(lptim)) {
+		LL_LPTIM_ClearFlag_ARRM(lptim);
+
+		if (get_data(dev)->is_reloaded) {
+			get_data(dev)->overflows++;
+		}
+	}
+}
+
+static int stm32_lptim_pulse_init(const struct device *dev)
+{
+	int ret;
+
+	const struct stm32_lptim_pulse_config *config = get_config(dev);
+	const struct device *clk = DEVICE_DT_GET(STM32_CLOCK_CONTROL_NODE);
+
+	if (!device_is_ready(clk)) {
+		LOG_ERR("Clock control device not ready");
+		return -ENODEV;
+	}
+
+	ret = clock_control_on(clk, (clock_control_subsys_t)&config->pclken);
+	if (ret) {
+		LOG_ERR("Call `clock_control_on` failed: %d", ret);
+		return ret;
+	}
+
+	ret = pinctrl_apply_state(config->pcfg, PINCTRL_STATE_DEFAULT);
+	if (ret) {
+		LOG_ERR("Call `pinctrl_apply_state` failed: %d", ret);
+		return ret;
+	}
+
+	/* Clocked by the edges on IN1 (no kernel clock needed, works in low-power modes) */
+	LL_LPTIM_Disable(config->lptim);
+	LL_LPTIM_SetClockSource(config->lptim, LL_LPTIM_CLK_SOURCE_EXTERNAL);
+	LL_LPTIM_SetClockPolarity(config->lptim, config->polarity);
+	LL_LPTIM_SetCounterMode(config->lptim, LL_LPTIM_COUNTER_MODE_EXTERNAL);
+	LL_LPTIM_SetInput1Src(config->lptim, LL_LPTIM_INPUT1_SRC_GPIO);
+
+	config->irq_config(dev);
+
+	return 0;
+}
+
+#define STM32_LPTIM_PULSE_POLARITY(n)                                                              \
+	(DT_INST_ENUM_IDX(n, edge) == 0   ? LL_LPTIM_CLK_POLARITY_RISING                           \
+	 : DT_INST_ENUM_IDX(n, edge) == 1 ? LL_LPTIM_CLK_POLARITY_FALLING                          \
+					  : LL_LPTIM_CLK_POLARITY_RISING_FALLING)
+
+#define STM32_LPTIM_PULSE_INIT(n)                                                                  \
+	PINCTRL_DT_INST_DEFINE(n);                                                                 \
+	static void inst_##n##_irq_config(const struct device *dev)                                \
+	{                                                                                          \
+		IRQ_CONNECT(DT_INST_IRQN(n), DT_INST_IRQ(n, priority), stm32_lptim_pulse_isr,      \
+			    DEVICE_DT_INST_GET(n), 0);                                             \
+		irq_enable(DT_INST_IRQN(n));                                                       \
+	}                                                                                          \
+	static const struct stm32_lptim_pulse_config inst_##n##_config = {                         \
+		.info =                                                                            \
+			{                                                                          \
+				.max_top_value = UINT32_MAX,                                       \
+				.freq = 0,                                                         \
+				.flags = COUNTER_CONFIG_INFO_COUNT_UP,                             \
+				.channels = 0,                                                     \
+			},                                                                         \
+		.lptim = (LPTIM_TypeDef *)DT_INST_REG_ADDR(n),                                     \
+		.pclken = STM32_CLOCK_INFO(0, DT_DRV_INST(n)),                                     \
+		.pcfg = PINCTRL_DT_INST_DEV_CONFIG_GET(n),                                         \
+		.polarity = STM32_LPTIM_PULSE_POLARITY(n),                                         \
+		.irq_config = inst_##n##_irq_config,                                               \
+	};                                                                                         \
+	static struct stm32_lptim_pulse_data inst_##n##_data;                                      \
+	DEVICE_DT_INST_DEFINE(n, stm32_lptim_pulse_init, NULL, &inst_##n##_data,                   \
+			      &inst_##n##_config, PRE_KERNEL_1, CONFIG_COUNTER_INIT_PRIORITY,      \
+			      &stm32_lptim_pulse_driver_api);
+
+DT_INST_FOREACH_STATUS_OKAY(STM32_LPTIM_PULSE_INIT)
@@ -4,8 +4,11 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <sticker/drivers/sensor/mpl3115a2.h>
+
 /* Zephyr includes */
 #include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
 #include <zephyr/drivers/i2c.h>
 #include <zephyr/drivers/sensor.h>
 #include <zephyr/kernel.h>
@@ -17,6 +20,7 @@
 #include <errno.h>
 #include <float.h>
 #include <math.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -29,24 +33,44 @@ LOG_MODULE_REGISTER(mpl3115a2, CONFIG_SENSOR_LOG_LEVEL);
 #define MPL3115A2_REG_WHO_AM_I    0x0c
 #define MPL3115A2_REG_PT_DATA_CFG 0x13
 #define MPL3115A2_REG_CTRL_REG1   0x26
+#define MPL3115A2_REG_CTRL_REG3   0x28
+#define MPL3115A2_REG_CTRL_REG4   0x29
+#define MPL3115A2_REG_CTRL_REG5   0x2a
 
 #define MPL3115A2_VALUE_WHO_AM_I 0xc4
 
 #define MPL3115A2_RESET_DELAY_MSEC 1000
-#define MPL3115A2_CONV_TIME_MSEC   512
+
+/* Default value of BAR_IN register used by the sensor in altimeter mode */
+#define MPL3115A2_SEA_LEVEL_PRESSURE_PA 101326.f
 
 struct mpl3115a2_data {
 	float altitude;
 	float pressure;
 	float temperature;
 	int64_t reset_time;
+#if defined(CONFIG_MPL3115A2_TRIGGER)
+	const struct device *dev;
+	struct k_work_delayable drdy_work;
+	struct gpio_callback gpio_cb;
+	sensor_trigger_handler_t drdy_handler;
+	const struct sensor_trigger *drdy_trigger;
+	bool is_int_configured;
+#endif /* defined(CONFIG_MPL3115A2_TRIGGER) */
 };
 
 struct mpl3115a2_config {
 	const struct device *i2c_dev;
 	uint16_t i2c_addr;
+	uint8_t os;
+#if defined(CONFIG_MPL3115A2_TRIGGER)
+	struct gpio_dt_spec int_gpio;
+#endif /* defined(CONFIG_MPL3115A2_TRIGGER) */
 };
 
+/* Conversion time per oversampling setting (2^os) */
+static const uint16_t m_conv_time_msec[] = {6, 10, 18, 34, 66, 130, 258, 512};
+
 static inline const struct mpl3115a2_config *get_config(const struct device *dev)
 {
 	return dev->config;
@@ -101,12 +125,14 @@ static int write(const struct device *dev, uint8_t reg, uint8_t data)
 	return 0;
 }
 
-static int sample_altitude(const struct device *dev)
+static int start_conversion(const struct device *dev, bool altimeter)
 {
 	int ret;
 
-	/* Set altimeter mode, set oversampling 2^7 = 128 */
-	ret = write(dev, MPL3115A2_REG_CTRL_REG1, 0xb8);
+	/* Set altimeter or barometer mode, set oversampling 2^os */
+	uint8_t ctrl_reg1 = (altimeter ? 0x80 : 0x00) | (get_config(dev)->os << 3);
+
+	ret = write(dev, MPL3115A2_REG_CTRL_REG1, ctrl_reg1);
 	if (ret) {
 		LOG_ERR("Call `write` failed: %d", ret);
 		return ret;
@@ -119,15 +145,19 @@ static int sample_altitude(const struct device *dev)
 		return ret;
 	}
 
-	/* Initiate altitute measurement */
-	ret = write(dev, MPL3115A2_REG_CTRL_REG1, 0xba);
+	/* Initiate one-shot measurement */
+	ret = write(dev, MPL3115A2_REG_CTRL_REG1, ctrl_reg1 | 0x02);
 	if (ret) {
 		LOG_ERR("Call `write` failed: %d", ret);
 		return ret;
 	}
 
-	/* Measurement delay */
-	k_sleep(K_MSEC(MPL3115A2_CONV_TIME_MSEC));
+	return 0;
+}
+
+static int read_conversion(const struct device *dev, bool altimeter)
+{
+	int ret;
 
 	/* Check STATUS register */
 	uint8_t reg_status;
@@ -143,7 +173,7 @@ static int sample_altitude(const struct device *dev)
 		return -EACCES;
 	}
 
-	/* Read 5 bytes, 3 for altitude and 2 for temperature */
+	/* Read 5 bytes, 3 for altitude or pressure and 2 for temperature */
 	uint8_t buffer[5];
 	ret = read(dev, MPL3115A2_REG_OUT_P_MSB, buffer, sizeof(buffer));
 	if (ret) {
@@ -151,100 +181,291 @@ static int sample_altitude(const struct device *dev)
 		return ret;
 	}
 
-	int32_t raw = (int32_t)sys_get_be24(&buffer[0]);
-	if (raw & 0x800000) {
-		raw |= 0xFF000000;
+	if (altimeter) {
+		int32_t raw = (int32_t)sys_get_be24(&buffer[0]);
+		if (raw & 0x800000) {
+			raw |= 0xFF000000;
+		}
+		get_data(dev)->altitude = ((int32_t)((uint32_t)raw << 8) >> 12) / 16.f;
+	} else {
+		uint32_t p = sys_get_be24(&buffer[0]) << 8;
+		get_data(dev)->pressure = (p >> 12) / 4000.f;
+
+#if defined(CONFIG_MPL3115A2_ALTITUDE_FROM_PRESSURE)
+		/* Same barometric formula as the sensor uses in altimeter mode */
+		get_data(dev)->altitude =
+			44330.77f * (1.f - powf(get_data(dev)->pressure * 1000.f /
+						       MPL3115A2_SEA_LEVEL_PRESSURE_PA,
+					       0.1902632f));
+#endif /* defined(CONFIG_MPL3115A2_ALTITUDE_FROM_PRESSURE) */
 	}
-	get_data(dev)->altitude = ((int32_t)((uint32_t)raw << 8) >> 12) / 16.f;
+
 	get_data(dev)->temperature = (int8_t)buffer[3] + (buffer[4] >> 4) / 16.f;
 
 	return 0;
 }
 
-static int sample_pressure(const struct device *dev)
+static void wait_reset(const struct device *dev)
+{
+	/* Check if delay after the reset and initialization passed */
+	int64_t delta = k_uptime_get() - get_data(dev)->reset_time;
+	if (delta < MPL3115A2_RESET_DELAY_MSEC) {
+		k_sleep(K_MSEC(MPL3115A2_RESET_DELAY_MSEC - delta));
+	}
+}
+
+static int sample(const struct device *dev, bool altimeter)
+{
+	int ret;
+
+	ret = start_conversion(dev, altimeter);
+	if (ret) {
+		LOG_ERR("Call `start_conversion` failed: %d", ret);
+		return ret;
+	}
+
+	/* Measurement delay */
+	k_sleep(K_MSEC(m_conv_time_msec[get_config(dev)->os]));
+
+	ret = read_conversion(dev, altimeter);
+	if (ret) {
+		LOG_ERR("Call `read_conversion` failed: %d", ret);
+		return ret;
+	}
+
+	return 0;
+}
+
+#if defined(CONFIG_MPL3115A2_TRIGGER)
+static int configure_int(const struct device *dev)
 {
 	int ret;
 
-	/* Set pressure mode, set oversampling 2^7 = 128 */
-	ret = write(dev, MPL3115A2_REG_CTRL_REG1, 0x38);
+	/* Settings are lost by the reset, write them once before the first conversion */
+	if (get_data(dev)->is_int_configured) {
+		return 0;
+	}
+
+	/* INT1 active high, push-pull */
+	ret = write(dev, MPL3115A2_REG_CTRL_REG3, 0x20);
 	if (ret) {
 		LOG_ERR("Call `write` failed: %d", ret);
 		return ret;
 	}
 
-	/* Activate altitude, pressure and temperature event flag generator */
-	ret = write(dev, MPL3115A2_REG_PT_DATA_CFG, 0x07);
+	/* Enable data ready interrupt */
+	ret = write(dev, MPL3115A2_REG_CTRL_REG4, 0x80);
 	if (ret) {
 		LOG_ERR("Call `write` failed: %d", ret);
 		return ret;
 	}
 
-	/* Initiate pressure measurement */
-	ret = write(dev, MPL3115A2_REG_CTRL_REG1, 0x3a);
+	/* Route data ready interrupt to INT1 */
+	ret = write(dev, MPL3115A2_REG_CTRL_REG5, 0x80);
 	if (ret) {
 		LOG_ERR("Call `write` failed: %d", ret);
 		return ret;
 	}
 
-	/* Measurement delay */
-	k_sleep(K_MSEC(MPL3115A2_CONV_TIME_MSEC));
+	get_data(dev)->is_int_configured = true;
 
-	/* Check STATUS register */
-	uint8_t reg_status;
-	ret = read(dev, MPL3115A2_REG_STATUS, &reg_status, sizeof(reg_status));
+	return 0;
+}
+
+static int arm_trigger(const struct device *dev)
+{
+	int ret;
+
+	if (!get_data(dev)->drdy_handler) {
+		return 0;
+	}
+
+	int conv_time = m_conv_time_msec[get_config(dev)->os];
+
+	if (!get_config(dev)->int_gpio.port) {
+		/* No interrupt line, complete after the nominal conversion time */
+		k_work_reschedule(&get_data(dev)->drdy_work, K_MSEC(conv_time));
+		return 0;
+	}
+
+	ret = gpio_pin_interrupt_configure_dt(&get_config(dev)->int_gpio, GPIO_INT_EDGE_TO_ACTIVE);
 	if (ret) {
-		LOG_ERR("Call `read` failed: %d", ret);
+		LOG_ERR("Call `gpio_pin_interrupt_configure_dt` failed: %d", ret);
 		return ret;
 	}
 
-	/* Check if data is ready */
-	if ((reg_status & 0x0e) != 0x0e) {
-		LOG_ERR("Data not ready");
-		return -EACCES;
+	/* Fallback in case the interrupt edge gets lost */
+	k_work_reschedule(&get_data(dev)->drdy_work, K_MSEC(2 * conv_time));
+
+	return 0;
+}
+
+static void drdy_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct mpl3115a2_data *data = CONTAINER_OF(dwork, struct mpl3115a2_data, drdy_work);
+	const struct mpl3115a2_config *config = data->dev->config;
+
+	if (config->int_gpio.port) {
+		gpio_pin_interrupt_configure_dt(&config->int_gpio, GPIO_INT_DISABLE);
 	}
 
-	/* Read 5 bytes, 3 for altitude and 2 for temperature */
-	uint8_t buffer[5];
-	ret = read(dev, MPL3115A2_REG_OUT_P_MSB, buffer, sizeof(buffer));
+	if (data->drdy_handler) {
+		data->drdy_handler(data->dev, data->drdy_trigger);
+	}
+}
+
+static void int_gpio_callback(const struct device *port, struct gpio_callback *cb, uint32_t pins)
+{
+	struct mpl3115a2_data *data = CONTAINER_OF(cb, struct mpl3115a2_data, gpio_cb);
+
+	k_work_reschedule(&data->drdy_work, K_NO_WAIT);
+}
+
+static int mpl3115a2_trigger_set(const struct device *dev, const struct sensor_trigger *trig,
+				 sensor_trigger_handler_t handler)
+{
+	if (trig->type != SENSOR_TRIG_DATA_READY) {
+		return -ENOTSUP;
+	}
+
+	get_data(dev)->drdy_handler = handler;
+	get_data(dev)->drdy_trigger = trig;
+
+	return 0;
+}
+
+static int init_trigger(const struct device *dev)
+{
+	int ret;
+
+	get_data(dev)->dev = dev;
+
+	k_work_init_delayable(&get_data(dev)->drdy_work, drdy_work_handler);
+
+	if (!get_config(dev)->int_gpio.port) {
+		return 0;
+	}
+
+	if (!gpio_is_ready_dt(&get_config(dev)->int_gpio)) {
+		LOG_ERR("Device not ready");
+		return -ENODEV;
+	}
+
+	ret = gpio_pin_configure_dt(&get_config(dev)->int_gpio, GPIO_INPUT);
 	if (ret) {
-		LOG_ERR("Call `read` failed: %d", ret);
+		LOG_ERR("Call `gpio_pin_configure_dt` failed: %d", ret);
 		return ret;
 	}
 
-	uint32_t p = sys_get_be24(&buffer[0]) << 8;
-	get_data(dev)->pressure = (p >> 12) / 4000.f;
-	get_data(dev)->temperature = (int8_t)buffer[3] + (buffer[4] >> 4) / 16.f;
+	gpio_init_callback(&get_data(dev)->gpio_cb, int_gpio_callback,
+			   BIT(get_config(dev)->int_gpio.pin));
+
+	ret = gpio_add_callback(get_config(dev)->int_gpio.port, &get_data(dev)->gpio_cb);
+	if (ret) {
+		LOG_ERR("Call `gpio_add_callback` failed: %d", ret);
+		return ret;
+	}
 
 	return 0;
 }
+#endif /* defined(CONFIG_MPL3115A2_TRIGGER) */
+
+static bool is_altimeter(enum sensor_channel chan)
+{
+	/* Altitude is derived from the barometer conversion if enabled */
+	return chan == SENSOR_CHAN_ALTITUDE && !IS_ENABLED(CONFIG_MPL3115A2_ALTITUDE_FROM_PRESSURE);
+}
 
 static int mpl3115a2_sample_fetch(const struct device *dev, enum sensor_channel chan)
 {
 	int ret;
 
-	/* Check if delay after the reset and initialization passed */
-	int64_t delta = k_uptime_get() - get_data(dev)->reset_time;
-	if (delta < MPL3115A2_RESET_DELAY_MSEC) {
-		k_sleep(K_MSEC(MPL3115A2_RESET_DELAY_MSEC - delta));
-	}
+	wait_reset(dev);
 
+#if defined(CONFIG_MPL3115A2_ALTITUDE_FROM_PRESSURE)
+	/* Single barometer conversion provides all channels */
+	if (chan == SENSOR_CHAN_ALTITUDE || chan == SENSOR_CHAN_PRESS ||
+	    chan == SENSOR_CHAN_AMBIENT_TEMP || chan == SENSOR_CHAN_ALL) {
+		ret = sample(dev, false);
+		if (ret) {
+			LOG_ERR("Call `sample` failed: %d", ret);
+			return ret;
+		}
+	}
+#else
 	/* Sensor measures temperature together with altitude or pressure measurement */
 	if (chan == SENSOR_CHAN_ALTITUDE || chan == SENSOR_CHAN_AMBIENT_TEMP ||
 	    chan == SENSOR_CHAN_ALL) {
-		ret = sample_altitude(dev);
+		ret = sample(dev, true);
 		if (ret) {
-			LOG_ERR("Call `sample_altitude` failed: %d", ret);
+			LOG_ERR("Call `sample` failed: %d", ret);
 			return ret;
 		}
 	}
 
 	if (chan == SENSOR_CHAN_PRESS || chan == SENSOR_CHAN_ALL) {
-		ret = sample_pressure(dev);
+		ret = sample(dev, false);
+		if (ret) {
+			LOG_ERR("Call `sample` failed: %d", ret);
+			return ret;
+		}
+	}
+#endif /* defined(CONFIG_MPL3115A2_ALTITUDE_FROM_PRESSURE) */
+
+	return 0;
+}
+
+int mpl3115a2_start(const struct device *dev, enum sensor_channel chan)
+{
+	int ret;
+
+	if (chan != SENSOR_CHAN_ALTITUDE && chan != SENSOR_CHAN_PRESS) {
+		return -ENOTSUP;
+	}
+
+	wait_reset(dev);
+
+#if defined(CONFIG_MPL3115A2_TRIGGER)
+	if (get_data(dev)->drdy_handler && get_config(dev)->int_gpio.port) {
+		ret = configure_int(dev);
 		if (ret) {
-			LOG_ERR("Call `sample_pressure` failed: %d", ret);
+			LOG_ERR("Call `configure_int` failed: %d", ret);
 			return ret;
 		}
 	}
+#endif /* defined(CONFIG_MPL3115A2_TRIGGER) */
+
+	ret = start_conversion(dev, is_altimeter(chan));
+	if (ret) {
+		LOG_ERR("Call `start_conversion` failed: %d", ret);
+		return ret;
+	}
+
+#if defined(CONFIG_MPL3115A2_TRIGGER)
+	ret = arm_trigger(dev);
+	if (ret) {
+		LOG_ERR("Call `arm_trigger` failed: %d", ret);
+		return ret;
+	}
+#endif /* defined(CONFIG_MPL3115A2_TRIGGER) */
+
+	return m_conv_time_msec[get_config(dev)->os];
+}
+
+int mpl3115a2_collect(const struct device *dev, enum sensor_channel chan)
+{
+	int ret;
+
+	if (chan != SENSOR_CHAN_ALTITUDE && chan != SENSOR_CHAN_PRESS) {
+		return -ENOTSUP;
+	}
+
+	ret = read_conversion(dev, is_altimeter(chan));
+	if (ret) {
+		LOG_ERR("Call `read_conversion` failed: %d", ret);
+		return ret;
+	}
 
 	return 0;
 }
@@ -286,18 +507,32 @@ static int mpl3115a2_init(const struct device *dev)
 
 	get_data(dev)->reset_time = k_uptime_get();
 
+#if defined(CONFIG_MPL3115A2_TRIGGER)
+	ret = init_trigger(dev);
+	if (ret) {
+		LOG_ERR("Call `init_trigger` failed: %d", ret);
+		return ret;
+	}
+#endif /* defined(CONFIG_MPL3115A2_TRIGGER) */
+
 	return 0;
 }
 
 static const struct sensor_driver_api mpl3115a2_driver_api = {
 	.sample_fetch = mpl3115a2_sample_fetch,
 	.channel_get = mpl3115a2_channel_get,
+#if defined(CONFIG_MPL3115A2_TRIGGER)
+	.trigger_set = mpl3115a2_trigger_set,
+#endif /* defined(CONFIG_MPL3115A2_TRIGGER) */
 };
 
 #define MPL3115_A2_INIT(n)                                                                         \
 	static const struct mpl3115a2_config inst_##n##_config = {                                 \
 		.i2c_dev = DEVICE_DT_GET(DT_INST_BUS(n)),                                          \
 		.i2c_addr = DT_INST_REG_ADDR(n),                                                   \
+		.os = DT_INST_ENUM_IDX(n, oversampling),                                           \
+		IF_ENABLED(CONFIG_MPL3115A2_TRIGGER,                                               \
+			   (.int_gpio = GPIO_DT_SPEC_INST_GET_OR(n, int_gpios, {0}),))             \
 	};                                                                                         \
 	static struct mpl3115a2_data inst_##n##_data;                                              \
 	SENSOR_DEVICE_DT_INST_DEFINE(n, mpl3115a2_init, NULL, &inst_##n##_data,                    \
@@ -16,6 +16,7 @@
 #include <zephyr/sys/byteorder.h>
 
 /* Standard includes */
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <string.h>
@@ -30,8 +31,9 @@ LOG_MODULE_REGISTER(ds28e17, CONFIG_W1_LOG_LEVEL);
 #define DEV_CMD_WRITE_CONFIG         0xd2
 #define DEV_CMD_ENABLE_SLEEP         0x1e
 
-#define POLL_BUSY_MAX_ATTEMPTS 100
-#define POLL_BUSY_DELAY        K_MSEC(10)
+/* Back-off of the busy poll is capped at the delay, the total wait at the timeout */
+#define POLL_BUSY_MAX_DELAY_US 10000
+#define POLL_BUSY_TIMEOUT_MS   1000
 
 /* Max I2C write payload per transaction. The DS28E17 supports up to 255 but
  * callers in this project use at most a few bytes. Limiting this keeps the
@@ -46,6 +48,14 @@ struct ds28e17_config {
 struct ds28e17_data {
 	const struct device *dev;
 	struct w1_slave_config config;
+	enum ds28e17_i2c_speed i2c_speed;
+};
+
+/* I2C time of a byte (8 data bits and acknowledge) in microseconds */
+static const uint16_t m_i2c_byte_time_us[] = {
+	[DS28E17_I2C_SPEED_100_KHZ] = 90,
+	[DS28E17_I2C_SPEED_400_KHZ] = 23,
+	[DS28E17_I2C_SPEED_900_KHZ] = 10,
 };
 
 static inline const struct ds28e17_config *get_config(const struct device *dev)
@@ -69,11 +79,21 @@ static int ds28e17_set_w1_config_(const struct device *dev, struct w1_slave_conf
 	return 0;
 }
 
-static int poll_busy(const struct device *dev)
+/* Sleep for the expected I2C time of the segment, then poll with an increasing delay */
+static int poll_busy(const struct device *dev, const struct ds28e17_i2c_msg *msg)
 {
 	int ret;
 
-	for (int i = 0; i < POLL_BUSY_MAX_ATTEMPTS; i++) {
+	/* Address byte and data of each direction */
+	size_t bytes = (msg->write_len ? 1 + msg->write_len : 0) +
+		       (msg->read_len ? 1 + msg->read_len : 0);
+
+	uint32_t delay_us = bytes * m_i2c_byte_time_us[get_data(dev)->i2c_speed];
+	int64_t deadline = k_uptime_get() + POLL_BUSY_TIMEOUT_MS;
+
+	for (;;) {
+		k_sleep(K_USEC(delay_us));
+
 		ret = w1_read_bit(get_config(dev)->bus);
 		if (ret < 0) {
 			LOG_ERR("Call `w1_read_bit` failed: %d", ret);
@@ -82,179 +102,113 @@ static int poll_busy(const struct device *dev)
 			return 0;
 		}
 
-		k_sleep(POLL_BUSY_DELAY);
-	}
+		if (k_uptime_get() > deadline) {
+			return -ETIMEDOUT;
+		}
 
-	return -ETIMEDOUT;
+		/* Slave is stretching the clock */
+		delay_us = MIN(delay_us * 2, POLL_BUSY_MAX_DELAY_US);
+	}
 }
 
-static int ds28e17_i2c_write_(const struct device *dev, uint8_t dev_addr, const uint8_t *write_buf,
-			      size_t write_len)
+static int transfer_msg(const struct device *dev, const struct ds28e17_i2c_msg *msg, bool resume)
 {
 	int ret;
 
-	if (write_len < 1 || write_len > MAX_WRITE_LEN) {
-		return -EINVAL;
-	}
-
-	ret = w1_lock_bus(get_config(dev)->bus);
-	if (ret) {
-		LOG_ERR("Call `w1_lock_bus` failed: %d", ret);
-		return ret;
+	/* Device accepts one command per reset, the match of the first segment is resumed */
+	if (resume) {
+		ret = w1_resume_command(get_config(dev)->bus);
+		if (ret) {
+			LOG_ERR("Call `w1_resume_command` failed: %d", ret);
+			return ret;
+		}
+	} else {
+		ret = w1_reset_select(get_config(dev)->bus, &get_data(dev)->config);
+		if (ret) {
+			LOG_ERR("Call `w1_reset_select` failed: %d", ret);
+			return ret;
+		}
 	}
 
-	ret = w1_reset_select(get_config(dev)->bus, &get_data(dev)->config);
-	if (ret) {
-		LOG_ERR("Call `w1_reset_select` failed: %d", ret);
-		w1_unlock_bus(get_config(dev)->bus);
-		return ret;
-	}
+	uint8_t buf[3 + MAX_WRITE_LEN + 3];
+	size_t len = 0;
 
-	uint8_t buf[3 + MAX_WRITE_LEN + 2];
+	if (msg->write_len) {
+		buf[len++] = msg->read_len ? DEV_CMD_WRITE_READ_DATA_STOP : DEV_CMD_WRITE_DATA_STOP;
+		buf[len++] = msg->dev_addr << 1;
+		buf[len++] = msg->write_len;
 
-	buf[0] = DEV_CMD_WRITE_DATA_STOP;
-	buf[1] = dev_addr << 1;
-	buf[2] = write_len;
+		memcpy(&buf[len], msg->write_buf, msg->write_len);
+		len += msg->write_len;
 
-	memcpy(&buf[3], write_buf, write_len);
+		if (msg->read_len) {
+			buf[len++] = msg->read_len;
+		}
+	} else {
+		buf[len++] = DEV_CMD_READ_DATA_STOP;
+		buf[len++] = msg->dev_addr << 1 | BIT(0);
+		buf[len++] = msg->read_len;
+	}
 
-	uint16_t crc16 = w1_crc16(W1_CRC16_SEED, buf, 3 + write_len);
-	sys_put_le16(~crc16, &buf[3 + write_len]);
+	uint16_t crc16 = w1_crc16(W1_CRC16_SEED, buf, len);
+	sys_put_le16(~crc16, &buf[len]);
+	len += 2;
 
-	ret = w1_write_block(get_config(dev)->bus, buf, 3 + write_len + 2);
+	ret = w1_write_block(get_config(dev)->bus, buf, len);
 	if (ret) {
 		LOG_ERR("Call `w1_write_block` failed: %d", ret);
-		w1_unlock_bus(get_config(dev)->bus);
 		return ret;
 	}
 
-	ret = poll_busy(dev);
+	ret = poll_busy(dev, msg);
 	if (ret) {
 		LOG_ERR("Call `poll_busy` failed: %d", ret);
-		w1_unlock_bus(get_config(dev)->bus);
 		return ret;
 	}
 
-	uint8_t status;
-	ret = w1_read_block(get_config(dev)->bus, &status, 1);
+	/* Status, followed by the write status if anything was written */
+	uint8_t status[2] = {0};
+	ret = w1_read_block(get_config(dev)->bus, status, msg->write_len ? 2 : 1);
 	if (ret) {
 		LOG_ERR("Call `w1_read_block` failed: %d", ret);
-		w1_unlock_bus(get_config(dev)->bus);
 		return ret;
 	}
 
-	if (status != 0) {
-		LOG_ERR("Error in status: 0x%02x", status);
-		w1_unlock_bus(get_config(dev)->bus);
+	if (status[0] != 0) {
+		LOG_ERR("Error in status: 0x%02x", status[0]);
 		return -EIO;
 	}
 
-	uint8_t write_status;
-	ret = w1_read_block(get_config(dev)->bus, &write_status, 1);
-	if (ret) {
-		LOG_ERR("Call `w1_read_block` failed: %d", ret);
-		w1_unlock_bus(get_config(dev)->bus);
-		return ret;
-	}
-
-	if (write_status != 0) {
-		LOG_ERR("Error in write status: 0x%02x", write_status);
-		w1_unlock_bus(get_config(dev)->bus);
+	if (status[1] != 0) {
+		LOG_ERR("Error in write status: 0x%02x", status[1]);
 		return -EIO;
 	}
 
-	ret = w1_unlock_bus(get_config(dev)->bus);
-	if (ret) {
-		LOG_ERR("Call `w1_unlock_bus` failed: %d", ret);
-		return ret;
+	if (msg->read_len) {
+		ret = w1_read_block(get_config(dev)->bus, msg->read_buf, msg->read_len);
+		if (ret) {
+			LOG_ERR("Call `w1_read_block` failed: %d", ret);
+			return ret;
+		}
 	}
 
 	return 0;
 }
 
-static int ds28e17_i2c_read_(const struct device *dev, uint8_t dev_addr, uint8_t *read_buf,
-			     size_t read_len)
+static int ds28e17_i2c_transfer_(const struct device *dev, const struct ds28e17_i2c_msg *msgs,
+				 size_t num_msgs)
 {
 	int ret;
 
-	if (read_len < 1 || read_len > 255) {
+	if (num_msgs < 1) {
 		return -EINVAL;
 	}
 
-	ret = w1_lock_bus(get_config(dev)->bus);
-	if (ret) {
-		LOG_ERR("Call `w1_lock_bus` failed: %d", ret);
-		return ret;
-	}
-
-	ret = w1_reset_select(get_config(dev)->bus, &get_data(dev)->config);
-	if (ret) {
-		LOG_ERR("Call `w1_reset_select` failed: %d", ret);
-		w1_unlock_bus(get_config(dev)->bus);
-		return ret;
-	}
-
-	uint8_t buf[5];
-
-	buf[0] = DEV_CMD_READ_DATA_STOP;
-	buf[1] = dev_addr << 1 | BIT(0);
-	buf[2] = read_len;
-
-	uint16_t crc16 = w1_crc16(W1_CRC16_SEED, buf, 3);
-	sys_put_le16(~crc16, &buf[3]);
-
-	ret = w1_write_block(get_config(dev)->bus, buf, 3 + 2);
-	if (ret) {
-		LOG_ERR("Call `w1_write_block` failed: %d", ret);
-		w1_unlock_bus(get_config(dev)->bus);
-		return ret;
-	}
-
-	ret = poll_busy(dev);
-	if (ret) {
-		LOG_ERR("Call `poll_busy` failed: %d", ret);
-		w1_unlock_bus(get_config(dev)->bus);
-		return ret;
-	}
-
-	uint8_t status;
-	ret = w1_read_block(get_config(dev)->bus, &status, 1);
-	if (ret) {
-		LOG_ERR("Call `w1_read_block` failed: %d", ret);
-		w1_unlock_bus(get_config(dev)->bus);
-		return ret;
-	}
-
-	if (status != 0) {
-		LOG_ERR("Error in status: 0x%02x", status);
-		w1_unlock_bus(get_config(dev)->bus);
-		return -EIO;
-	}
-
-	ret = w1_read_block(get_config(dev)->bus, read_buf, read_len);
-	if (ret) {
-		LOG_ERR("Call `w1_read_block` failed: %d", ret);
-		w1_unlock_bus(get_config(dev)->bus);
-		return ret;
-	}
-
-	ret = w1_unlock_bus(get_config(dev)->bus);
-	if (ret) {
-		LOG_ERR("Call `w1_unlock_bus` failed: %d", ret);
-		return ret;
-	}
-
-	return 0;
-}
-
-static int ds28e17_i2c_write_read_(const struct device *dev, uint8_t dev_addr,
-				   const uint8_t *write_buf, size_t write_len, uint8_t *read_buf,
-				   size_t read_len)
-{
-	int ret;
-
-	if (write_len < 1 || write_len > MAX_WRITE_LEN || read_len < 1 || read_len > 255) {
-		return -EINVAL;
+	for (size_t i = 0; i < num_msgs; i++) {
+		if (msgs[i].write_len > MAX_WRITE_LEN || msgs[i].read_len > 255 ||
+		    (!msgs[i].write_len && !msgs[i].read_len)) {
+			return -EINVAL;
+		}
 	}
 
 	ret = w1_lock_bus(get_config(dev)->bus);
@@ -263,73 +217,13 @@ static int ds28e17_i2c_write_read_(const struct device *dev, uint8_t dev_addr,
 		return ret;
 	}
 
-	ret = w1_reset_select(get_config(dev)->bus, &get_data(dev)->config);
-	if (ret) {
-		LOG_ERR("Call `w1_reset_select` failed: %d", ret);
-		w1_unlock_bus(get_config(dev)->bus);
-		return ret;
-	}
-
-	uint8_t buf[3 + MAX_WRITE_LEN + 3];
-
-	buf[0] = DEV_CMD_WRITE_READ_DATA_STOP;
-	buf[1] = dev_addr << 1;
-	buf[2] = write_len;
-
-	memcpy(&buf[3], write_buf, write_len);
-
-	buf[3 + write_len] = read_len;
-
-	uint16_t crc16 = w1_crc16(W1_CRC16_SEED, buf, 3 + write_len + 1);
-	sys_put_le16(~crc16, &buf[3 + write_len + 1]);
-
-	ret = w1_write_block(get_config(dev)->bus, buf, 3 + write_len + 3);
-	if (ret) {
-		LOG_ERR("Call `w1_write_block` failed: %d", ret);
-		w1_unlock_bus(get_config(dev)->bus);
-		return ret;
-	}
-
-	ret = poll_busy(dev);
-	if (ret) {
-		LOG_ERR("Call `poll_busy` failed: %d", ret);
-		w1_unlock_bus(get_config(dev)->bus);
-		return ret;
-	}
-
-	uint8_t status;
-	ret = w1_read_block(get_config(dev)->bus, &status, 1);
-	if (ret) {
-		LOG_ERR("Call `w1_read_block` failed: %d", ret);
-		w1_unlock_bus(get_config(dev)->bus);
-		return ret;
-	}
-
-	if (status != 0) {
-		LOG_ERR("Error in status: 0x%02x", status);
-		w1_unlock_bus(get_config(dev)->bus);
-		return -EIO;
-	}
-
-	uint8_t write_status;
-	ret = w1_read_block(get_config(dev)->bus, &write_status, 1);
-	if (ret) {
-		LOG_ERR("Call `w1_read_block` failed: %d", ret);
-		w1_unlock_bus(get_config(dev)->bus);
-		return ret;
-	}
-
-	if (write_status != 0) {
-		LOG_ERR("Error in write status: 0x%02x", write_status);
-		w1_unlock_bus(get_config(dev)->bus);
-		return -EIO;
-	}
-
-	ret = w1_read_block(get_config(dev)->bus, read_buf, read_len);
-	if (ret) {
-		LOG_ERR("Call `w1_read_block` failed: %d", ret);
-		w1_unlock_bus(get_config(dev)->bus);
-		return ret;
+	for (size_t i = 0; i < num_msgs; i++) {
+		ret = transfer_msg(dev, &msgs[i], i > 0);
+		if (ret) {
+			LOG_ERR("Call `transfer_msg` failed (segment %zu): %d", i, ret);
+			w1_unlock_bus(get_config(dev)->bus);
+			return ret;
+		}
 	}
 
 	ret = w1_unlock_bus(get_config(dev)->bus);
@@ -375,6 +269,8 @@ static int ds28e17_write_config_(const struct device *dev, enum ds28e17_i2c_spee
 		return ret;
 	}
 
+	get_data(dev)->i2c_speed = i2c_speed;
+
 	ret = w1_unlock_bus(get_config(dev)->bus);
 	if (ret) {
 		LOG_ERR("Call `w1_unlock_bus` failed: %d", ret);
@@ -423,9 +319,7 @@ static int ds28e17_enable_sleep_(const struct device *dev)
 
 static const struct ds28e17_driver_api ds28e17_driver_api = {
 	.set_w1_config = ds28e17_set_w1_config_,
-	.i2c_read = ds28e17_i2c_read_,
-	.i2c_write = ds28e17_i2c_write_,
-	.i2c_write_read = ds28e17_i2c_write_read_,
+	.i2c_transfer = ds28e17_i2c_transfer_,
 	.write_config = ds28e17_write_config_,
 	.enable_sleep = ds28e17_enable_sleep_,
 };
@@ -447,6 +341,7 @@ static int ds28e17_init(const struct device *dev)
 	};                                                                                         \
 	static struct ds28e17_data inst_##n##_data = {                                             \
 		.dev = DEVICE_DT_INST_GET(n),                                                      \
+		.i2c_speed = DS28E17_I2C_SPEED_400_KHZ,                                            \
 	};                                                                                         \
 	DEVICE_DT_INST_DEFINE(n, ds28e17_init, NULL, &inst_##n##_data, &inst_##n##_config,         \
 			      POST_KERNEL, CONFIG_W1_INIT_PRIORITY, &ds28e17_driver_api);
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2025 HARDWARIO a.s.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef STICKER_INCLUDE_DRIVERS_SENSOR_MPL3115A2_H_
+#define STICKER_INCLUDE_DRIVERS_SENSOR_MPL3115A2_H_
+
+/* Zephyr includes */
+#include <zephyr/device.h>
+#include <zephyr/drivers/sensor.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Start one-shot altimeter (SENSOR_CHAN_ALTITUDE) or barometer (SENSOR_CHAN_PRESS) conversion,
+ * returns conversion time in milliseconds; with CONFIG_MPL3115A2_ALTITUDE_FROM_PRESSURE both
+ * channels run the barometer conversion and altitude is computed from pressure */
+int mpl3115a2_start(const struct device *dev, enum sensor_channel chan);
+
+/* Read result of conversion started by mpl3115a2_start(), returns -EACCES if not finished */
+int mpl3115a2_collect(const struct device *dev, enum sensor_channel chan);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STICKER_INCLUDE_DRIVERS_SENSOR_MPL3115A2_H_ */
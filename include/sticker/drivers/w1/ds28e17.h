@@ -25,22 +25,24 @@ enum ds28e17_i2c_speed {
 	DS28E17_I2C_SPEED_900_KHZ = 2,
 };
 
+/* I2C segment of a transaction: write, read, or write with repeated start and read */
+struct ds28e17_i2c_msg {
+	uint8_t dev_addr;
+	const uint8_t *write_buf;
+	size_t write_len;
+	uint8_t *read_buf;
+	size_t read_len;
+};
+
 typedef int (*ds28e17_api_set_w1_config)(const struct device *dev, struct w1_slave_config config);
-typedef int (*ds28e17_api_i2c_write)(const struct device *dev, uint8_t dev_addr,
-				     const uint8_t *write_buf, size_t write_len);
-typedef int (*ds28e17_api_i2c_read)(const struct device *dev, uint8_t dev_addr, uint8_t *read_buf,
-				    size_t read_len);
-typedef int (*ds28e17_api_i2c_write_read)(const struct device *dev, uint8_t dev_addr,
-					  const uint8_t *write_buf, size_t write_len,
-					  uint8_t *read_buf, size_t read_len);
+typedef int (*ds28e17_api_i2c_transfer)(const struct device *dev,
+					const struct ds28e17_i2c_msg *msgs, size_t num_msgs);
 typedef int (*ds28e17_api_write_config)(const struct device *dev, enum ds28e17_i2c_speed i2c_speed);
 typedef int (*ds28e17_api_enable_sleep)(const struct device *dev);
 
 struct ds28e17_driver_api {
 	ds28e17_api_set_w1_config set_w1_config;
-	ds28e17_api_i2c_write i2c_write;
-	ds28e17_api_i2c_read i2c_read;
-	ds28e17_api_i2c_write_read i2c_write_read;
+	ds28e17_api_i2c_transfer i2c_transfer;
 	ds28e17_api_write_config write_config;
 	ds28e17_api_enable_sleep enable_sleep;
 };
@@ -52,29 +54,52 @@ static inline int ds28e17_set_w1_config(const struct device *dev, struct w1_slav
 	return api->set_w1_config(dev, config);
 }
 
+/* Run the segments under one bus lock, the device is selected once and resumed for the rest */
+static inline int ds28e17_i2c_transfer(const struct device *dev,
+				       const struct ds28e17_i2c_msg *msgs, size_t num_msgs)
+{
+	const struct ds28e17_driver_api *api = (const struct ds28e17_driver_api *)dev->api;
+
+	return api->i2c_transfer(dev, msgs, num_msgs);
+}
+
 static inline int ds28e17_i2c_write(const struct device *dev, uint8_t dev_addr,
 				    const uint8_t *write_buf, size_t write_len)
 {
-	const struct ds28e17_driver_api *api = (const struct ds28e17_driver_api *)dev->api;
+	struct ds28e17_i2c_msg msg = {
+		.dev_addr = dev_addr,
+		.write_buf = write_buf,
+		.write_len = write_len,
+	};
 
-	return api->i2c_write(dev, dev_addr, write_buf, write_len);
+	return ds28e17_i2c_transfer(dev, &msg, 1);
 }
 
 static inline int ds28e17_i2c_read(const struct device *dev, uint8_t dev_addr, uint8_t *read_buf,
 				   size_t read_len)
 {
-	const struct ds28e17_driver_api *api = (const struct ds28e17_driver_api *)dev->api;
+	struct ds28e17_i2c_msg msg = {
+		.dev_addr = dev_addr,
+		.read_buf = read_buf,
+		.read_len = read_len,
+	};
 
-	return api->i2c_read(dev, dev_addr, read_buf, read_len);
+	return ds28e17_i2c_transfer(dev, &msg, 1);
 }
 
 static inline int ds28e17_i2c_write_read(const struct device *dev, uint8_t dev_addr,
 					 const uint8_t *write_buf, size_t write_len,
 					 uint8_t *read_buf, size_t read_len)
 {
-	const struct ds28e17_driver_api *api = (const struct ds28e17_driver_api *)dev->api;
-
-	return api->i2c_write_read(dev, dev_addr, write_buf, write_len, read_buf, read_len);
+	struct ds28e17_i2c_msg msg = {
+		.dev_addr = dev_addr,
+		.write_buf = write_buf,
+		.write_len = write_len,
+		.read_buf = read_buf,
+		.read_len = read_len,
+	};
+
+	return ds28e17_i2c_transfer(dev, &msg, 1);
 }
 
 static inline int ds28e17_write_config(const struct device *dev, enum ds28e17_i2c_speed i2c_speed)